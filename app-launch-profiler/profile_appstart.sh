@@ -88,6 +88,13 @@ for x in $(seq 1 ${COUNT}); do
     ubuntu-app-launch ${APP_NAME}
     sleep ${SLEEP_TIME}
     ubuntu-app-stop ${APP_NAME}
+    if [[  $WITH_CACHE == true ]]; then
+      # Only detects a disabled or unwritable cache, it doesn't tell which
+      # documents were loaded from it
+      if [ -z "$(ls -A ~/.cache/QML/Apps/${APP_NAME} 2>/dev/null)" ]; then
+        echo "The QML cache of ${APP_NAME} was not populated, check that the QML cache is enabled."
+      fi
+    fi
 done
 
 echo ${PASSWORD}|sudo -S bash -c 'lttng stop'
@@ -10,6 +10,7 @@ HEADERS += \
     $$PWD/timesource_p.h \
     $$PWD/touchownershipevent_p.h \
     $$PWD/touchregistry_p.h \
+    $$PWD/touchresampler_p.h \
     $$PWD/ubuntugesturesglobal.h \
     $$PWD/ubuntugesturesmodule.h \
     $$PWD/ucswipearea_p.h \
@@ -24,6 +25,7 @@ SOURCES += \
     $$PWD/timesource.cpp \
     $$PWD/touchownershipevent.cpp \
     $$PWD/touchregistry.cpp \
+    $$PWD/touchresampler.cpp \
     $$PWD/ubuntugesturesmodule.cpp \
     $$PWD/ucswipearea.cpp \
     $$PWD/unownedtouchevent.cpp
@@ -17,6 +17,7 @@
 #ifndef POOL_P_H
 #define POOL_P_H
 
+#include <QtCore/QBitArray>
 #include <QtCore/QVector>
 
 #include <UbuntuGestures/ubuntugesturesglobal.h>
@@ -27,6 +28,12 @@
   in a scenario where items are created and destroyed very frequently but the total number
   of items at any given time remains small. They're stored in a unordered fashion.
 
+  Vacant slots are chained in an intrusive free list and occupancy is tracked in a bitmap,
+  so both getEmptySlot() and freeSlot() are O(1). Occupied slots are additionally kept in a
+  dense list, so forEach() only visits live items regardless of how many slots the pool
+  has grown to. Slots freed from within forEach() are only unlinked from the dense list
+  once the outermost iteration finishes.
+
   To be used in Pool, ItemType needs to have the following methods:
 
   - ItemType();
@@ -37,7 +44,6 @@
   - bool isValid() const;
 
   Returns wheter the object holds a valid , "filled" state or is empty.
-  Used by Pool to check if the slot occupied by this object is actually available.
 
   - void reset();
 
@@ -47,7 +53,7 @@
 template <class ItemType> class Pool
 {
 public:
-    Pool() : m_lastUsedIndex(-1) {
+    Pool() : m_firstFree(-1), m_count(0), m_iterating(0), m_needsCompaction(false) {
     }
 
     class Iterator {
@@ -75,30 +81,46 @@ public:
     };
 
     ItemType &getEmptySlot() {
-        Q_ASSERT(m_lastUsedIndex < m_slots.size());
-
-        // Look for an in-between vacancy first
-        for (int i = 0; i < m_lastUsedIndex; ++i) {
-            ItemType &item = m_slots[i];
-            if (!item.isValid()) {
-                return item;
-            }
+        int index;
+        if (m_firstFree != -1) {
+            index = m_firstFree;
+            m_firstFree = m_slots.at(index).nextFree;
+        } else {
+            index = m_slots.size();
+            m_slots.resize(index + 1);
+            m_occupied.resize(index + 1);
         }
 
-        ++m_lastUsedIndex;
-        if (m_lastUsedIndex >= m_slots.size()) {
-            m_slots.resize(m_lastUsedIndex + 1);
+        Slot &slot = m_slots[index];
+        Q_ASSERT(!slot.item.isValid());
+        slot.nextFree = -1;
+        m_occupied.setBit(index);
+        // a slot freed during forEach() may still have its entry in the live list
+        if (slot.livePosition == -1) {
+            slot.livePosition = m_live.size();
+            m_live.append(index);
         }
+        ++m_count;
 
-        return m_slots[m_lastUsedIndex];
+        return slot.item;
     }
 
     void freeSlot(Iterator &iterator) {
-        m_slots[iterator.index].reset();
-        if (iterator.index == m_lastUsedIndex) {
-            do {
-                --m_lastUsedIndex;
-            } while (m_lastUsedIndex >= 0 && !m_slots.at(m_lastUsedIndex).isValid());
+        const int index = iterator.index;
+        Q_ASSERT(m_occupied.testBit(index));
+
+        Slot &slot = m_slots[index];
+        slot.item.reset();
+        m_occupied.clearBit(index);
+        slot.nextFree = m_firstFree;
+        m_firstFree = index;
+        --m_count;
+
+        if (m_iterating > 0) {
+            // keep the live list stable for the ongoing forEach()
+            m_needsCompaction = true;
+        } else {
+            unlinkLive(index);
         }
     }
 
@@ -110,23 +132,65 @@ public:
     // Returning true means it wants to continue the "for" loop, false
     // terminates the loop.
     template<typename Func> void forEach(Func func) {
+        ++m_iterating;
         Iterator it;
-        for (it.index = 0; it.index <= m_lastUsedIndex; ++it.index) {
-            it.item = &m_slots[it.index];
-            if (!it.item->isValid())
+        for (int i = 0; i < m_live.size(); ++i) {
+            it.index = m_live.at(i);
+            if (!m_occupied.testBit(it.index))
                 continue;
 
+            it.item = &m_slots[it.index].item;
             if (!func(it))
                 break;
         }
+        if (--m_iterating == 0 && m_needsCompaction) {
+            compactLive();
+        }
     }
 
-    bool isEmpty() const { return m_lastUsedIndex == -1; }
-
+    bool isEmpty() const { return m_count == 0; }
+    int count() const { return m_count; }
 
 private:
-    QVector<ItemType> m_slots;
-    int m_lastUsedIndex;
+    struct Slot {
+        Slot() : nextFree(-1), livePosition(-1) {}
+        ItemType item;
+        int nextFree;
+        int livePosition;
+    };
+
+    void unlinkLive(int index) {
+        Slot &slot = m_slots[index];
+        const int position = slot.livePosition;
+        const int movedIndex = m_live.last();
+        m_live[position] = movedIndex;
+        m_slots[movedIndex].livePosition = position;
+        m_live.removeLast();
+        slot.livePosition = -1;
+    }
+
+    void compactLive() {
+        int position = 0;
+        for (int i = 0; i < m_live.size(); ++i) {
+            const int index = m_live.at(i);
+            if (m_occupied.testBit(index)) {
+                m_live[position] = index;
+                m_slots[index].livePosition = position++;
+            } else {
+                m_slots[index].livePosition = -1;
+            }
+        }
+        m_live.resize(position);
+        m_needsCompaction = false;
+    }
+
+    QVector<Slot> m_slots;
+    QVector<int> m_live;
+    QBitArray m_occupied;
+    int m_firstFree;
+    int m_count;
+    int m_iterating;
+    bool m_needsCompaction;
 };
 
 #endif // POOL_P_H
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "touchresampler_p.h"
+
+UG_NAMESPACE_BEGIN
+
+TouchResampler::TouchResampler()
+    : m_first(0)
+    , m_count(0)
+    , m_maxPrediction(16)
+{
+}
+
+void TouchResampler::reset()
+{
+    m_first = 0;
+    m_count = 0;
+    m_velocity = QPointF();
+}
+
+void TouchResampler::addSample(const QPointF &point, qint64 time)
+{
+    if (m_count > 0 && time <= lastSampleTime()) {
+        // several samples delivered at once, keep the most recent position only
+        m_samples[(m_first + m_count - 1) % maxSamples].point = point;
+    } else {
+        if (m_count == maxSamples) {
+            m_first = (m_first + 1) % maxSamples;
+            m_count--;
+        }
+        Sample &sample = m_samples[(m_first + m_count) % maxSamples];
+        sample.point = point;
+        sample.time = time;
+        m_count++;
+    }
+    updateVelocity();
+}
+
+qint64 TouchResampler::lastSampleTime() const
+{
+    return m_count > 0 ? sampleAt(m_count - 1).time : -1;
+}
+
+bool TouchResampler::isPredicting(qint64 time) const
+{
+    return m_count > 0 && !m_velocity.isNull()
+        && time < lastSampleTime() + m_maxPrediction;
+}
+
+QPointF TouchResampler::positionAt(qint64 time) const
+{
+    if (m_count == 0) {
+        return QPointF();
+    }
+
+    const Sample &last = sampleAt(m_count - 1);
+    if (time >= last.time) {
+        const qint64 delta = qMin(time - last.time, qint64(m_maxPrediction));
+        return last.point + m_velocity * delta;
+    }
+
+    for (int i = m_count - 2; i >= 0; --i) {
+        const Sample &before = sampleAt(i);
+        if (before.time <= time) {
+            const Sample &after = sampleAt(i + 1);
+            const qreal ratio = qreal(time - before.time) / qreal(after.time - before.time);
+            return before.point + (after.point - before.point) * ratio;
+        }
+    }
+    return sampleAt(0).point;
+}
+
+void TouchResampler::updateVelocity()
+{
+    // Least-squares fit of position = velocity * time + offset, computed relatively
+    // to the most recent sample to keep the sums small.
+    const Sample &last = sampleAt(m_count - 1);
+    qreal sumT = 0., sumX = 0., sumY = 0., sumTT = 0., sumTX = 0., sumTY = 0.;
+    int n = 0;
+    for (int i = m_count - 1; i >= 0; --i) {
+        const Sample &sample = sampleAt(i);
+        const qreal t = sample.time - last.time;
+        if (t < -historyLength) {
+            break;
+        }
+        const qreal x = sample.point.x() - last.point.x();
+        const qreal y = sample.point.y() - last.point.y();
+        sumT += t;
+        sumX += x;
+        sumY += y;
+        sumTT += t * t;
+        sumTX += t * x;
+        sumTY += t * y;
+        n++;
+    }
+
+    const qreal denominator = n * sumTT - sumT * sumT;
+    if (n < 2 || qFuzzyIsNull(denominator)) {
+        m_velocity = QPointF();
+    } else {
+        m_velocity.setX((n * sumTX - sumT * sumX) / denominator);
+        m_velocity.setY((n * sumTY - sumT * sumY) / denominator);
+    }
+}
+
+UG_NAMESPACE_END
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016 Canonical, Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TOUCHRESAMPLER_P_H
+#define TOUCHRESAMPLER_P_H
+
+#include <QtCore/QPointF>
+
+#include <UbuntuGestures/ubuntugesturesglobal.h>
+
+UG_NAMESPACE_BEGIN
+
+/*
+  Resamples the positions of a touch point at arbitrary times, typically the
+  times at which frames are produced, out of the samples delivered by the input
+  stack at its own rate.
+
+  The velocity is estimated with a least-squares linear fit over the most recent
+  samples. Positions requested between two samples are interpolated, positions
+  requested past the last sample are extrapolated along the estimated velocity
+  for at most maxPrediction() milliseconds.
+
+  Times are in milliseconds, as given by a TimeSource.
+ */
+class UBUNTUGESTURES_EXPORT TouchResampler
+{
+public:
+    TouchResampler();
+
+    void reset();
+    void addSample(const QPointF &point, qint64 time);
+    bool isEmpty() const { return m_count == 0; }
+
+    // Time of the most recent sample, -1 if there's none.
+    qint64 lastSampleTime() const;
+
+    // Estimated velocity, in pixels per millisecond.
+    QPointF velocity() const { return m_velocity; }
+
+    // Maximum time the position can be extrapolated past the last sample.
+    void setMaxPrediction(int msecs) { m_maxPrediction = msecs; }
+    int maxPrediction() const { return m_maxPrediction; }
+
+    // Whether positionAt() still extrapolates a moving position at the given time.
+    bool isPredicting(qint64 time) const;
+
+    QPointF positionAt(qint64 time) const;
+
+private:
+    struct Sample {
+        QPointF point;
+        qint64 time;
+    };
+    static const int maxSamples = 8;
+    // Samples older than that (relatively to the most recent one) are not used
+    // to estimate the velocity.
+    static const int historyLength = 50;
+
+    const Sample &sampleAt(int index) const {
+        return m_samples[(m_first + index) % maxSamples];
+    }
+    void updateVelocity();
+
+    Sample m_samples[maxSamples];
+    QPointF m_velocity;
+    int m_first;
+    int m_count;
+    int m_maxPrediction;
+};
+
+UG_NAMESPACE_END
+
+#endif // TOUCHRESAMPLER_P_H
@@ -283,6 +283,20 @@ void UCSwipeAreaPrivate::setTimeSource(const SharedTimeSource &timeSource)
     activeTouches.m_timeSource = timeSource;
 }
 
+void UCSwipeAreaPrivate::setResampling(bool value)
+{
+    if (resampling == value) {
+        return;
+    }
+    resampling = value;
+    if (!resampling) {
+        if (status == Recognized && !touchResampler.isEmpty()) {
+            updatePosition(touchResampler.positionAt(touchResampler.lastSampleTime()));
+        }
+        stopResampling();
+    }
+}
+
 /*!
  * \qmlproperty real SwipeArea::distance
  * \readonly
@@ -645,12 +659,14 @@ void UCSwipeAreaPrivate::touchEvent_recognized(QTouchEvent *event)
             << "missing from QTouchEvent without first reaching state Qt::TouchPointReleased. "
                "Considering it as released.";
         setStatus(WaitingForTouch);
+    } else if (touchPoint->state() == Qt::TouchPointReleased) {
+        // no prediction on release, the final position is the actual one
+        updatePosition(touchPoint->scenePos());
+        setStatus(WaitingForTouch);
+    } else if (resampling) {
+        resamplePosition(touchPoint->scenePos());
     } else {
         updatePosition(touchPoint->scenePos());
-
-        if (touchPoint->state() == Qt::TouchPointReleased) {
-            setStatus(WaitingForTouch);
-        }
     }
 }
 
@@ -781,6 +797,9 @@ void UCSwipeAreaPrivate::setStatus(Status newStatus)
     const bool wasPressed = q->pressed();
 
     status = newStatus;
+    if (status == WaitingForTouch) {
+        stopResampling();
+    }
     for (int i = 0; i < statusChangeListeners.size(); i++) {
         statusChangeListeners[i]->swipeStatusChanged(oldStatus, status);
     }
@@ -839,6 +858,52 @@ void UCSwipeAreaPrivate::updatePosition(const QPointF &point)
     }
 }
 
+/*
+ * Records the touch position instead of publishing it right away. The position
+ * is published once per frame by UCSwipeArea::updateResampledPosition(), right
+ * before the scene graph gets synchronized, so that distance and touchPosition
+ * move at display rate no matter the rate at which touch events are delivered.
+ */
+void UCSwipeAreaPrivate::resamplePosition(const QPointF &point)
+{
+    Q_Q(UCSwipeArea);
+    QQuickWindow *window = q->window();
+    if (!window) {
+        updatePosition(point);
+        return;
+    }
+
+    touchResampler.addSample(point, timeSource->msecsSinceReference());
+    if (!frameConnection) {
+        frameConnection = QObject::connect(window, &QQuickWindow::afterAnimating,
+                                           q, &UCSwipeArea::updateResampledPosition);
+    }
+    window->update();
+}
+
+void UCSwipeAreaPrivate::stopResampling()
+{
+    if (frameConnection) {
+        QObject::disconnect(frameConnection);
+    }
+    touchResampler.reset();
+}
+
+void UCSwipeArea::updateResampledPosition()
+{
+    Q_D(UCSwipeArea);
+    if (d->status != UCSwipeAreaPrivate::Recognized || d->touchResampler.isEmpty()) {
+        return;
+    }
+
+    const qint64 frameTime = d->timeSource->msecsSinceReference();
+    d->updatePosition(d->touchResampler.positionAt(frameTime));
+    if (d->touchResampler.isPredicting(frameTime) && window()) {
+        // the finger is assumed to keep moving until the prediction expires
+        window()->update();
+    }
+}
+
 bool UCSwipeAreaPrivate::isWithinTouchCompositionWindow()
 {
     return
@@ -851,6 +916,7 @@ bool UCSwipeAreaPrivate::isWithinTouchCompositionWindow()
 void UCSwipeArea::itemChange(ItemChange change, const ItemChangeData &value)
 {
     if (change == QQuickItem::ItemSceneChange) {
+        d_func()->stopResampling();
         if (value.window != nullptr) {
             value.window->installEventFilter(TouchRegistry::instance());
 
@@ -1028,6 +1094,7 @@ UCSwipeAreaPrivate::UCSwipeAreaPrivate()
     , direction(UCSwipeArea::Rightwards)
     , immediateRecognition(false)
     , grabGesture(true)
+    , resampling(qEnvironmentVariableIsSet("UC_SWIPEAREA_RESAMPLING"))
 {
 }
 
@@ -92,6 +92,7 @@ protected:
     // functors
     void giveUpIfDisabledOrInvisible();
     void rejectGesture();
+    void updateResampledPosition();
 
 private:
     Q_DECLARE_PRIVATE(UCSwipeArea)
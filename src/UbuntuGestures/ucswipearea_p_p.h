@@ -22,6 +22,7 @@
 #include <QtQuick/private/qquickitem_p.h>
 
 #include <UbuntuGestures/private/damper_p.h>
+#include <UbuntuGestures/private/touchresampler_p.h>
 
 UG_NAMESPACE_BEGIN
 
@@ -75,6 +76,11 @@ public:
     // Useful for testing, where a fake time source can be supplied
     void setTimeSource(const UG_PREPEND_NAMESPACE(SharedTimeSource) &timeSource);
 
+    // When enabled, the touch position of a recognized gesture is resampled
+    // at frame rate instead of following the touch events as they come.
+    // Disabled by default, unless UC_SWIPEAREA_RESAMPLING is set.
+    void setResampling(bool value);
+
     // Describes the state of the directional drag gesture.
     enum Status {
         // Waiting for a new touch point to land on this area. No gesture is being processed
@@ -105,6 +111,8 @@ public:
     const QTouchEvent::TouchPoint *fetchTargetTouchPoint(QTouchEvent *event);
     void setStatus(Status newStatus);
     void updatePosition(const QPointF &point);
+    void resamplePosition(const QPointF &point);
+    void stopResampling();
     void setPublicScenePos(const QPointF &point);
     bool isWithinTouchCompositionWindow();
     void updateSceneDirectionVector();
@@ -136,6 +144,9 @@ public:
     // Unit vector in scene coordinates describing the direction of the gesture recognition
     QPointF sceneDirectionVector;
     UG_PREPEND_NAMESPACE(SharedTimeSource) timeSource;
+    // Touch samples of the recognized gesture, resampled on each frame.
+    UG_PREPEND_NAMESPACE(TouchResampler) touchResampler;
+    QMetaObject::Connection frameConnection;
     ActiveTouchesInfo activeTouches;
 
     // status change listeners
@@ -165,6 +176,7 @@ public:
 
     bool immediateRecognition;
     bool grabGesture;
+    bool resampling;
 };
 
 class UBUNTUGESTURES_EXPORT UCSwipeAreaStatusListener
@@ -19,6 +19,7 @@
 
 #include <QtCore/QTimer>
 #include <QtGui/QGuiApplication>
+#include <QtGui/QMouseEvent>
 #include <QtQuick/QQuickWindow>
 
 // FIXME(loicm) When a monitored window is destroyed and if there's a window
@@ -27,6 +28,11 @@
 
 const int logQueueSize = 16;
 const int logQueueAlignment = 64;
+// Input not observed by a synchronization pass within that time (in
+// nanoseconds, about 15 frames at 60 Hz) is considered as not having caused a
+// frame, like a hover move with no visual change. It's dropped so that an
+// unrelated frame rendered later doesn't report the idle time as latency.
+const quint64 maxPendingInputAge = 250000000;
 
 LoggingThread::LoggingThread()
     : m_loggerCount(0)
@@ -165,7 +171,7 @@ UMApplicationMonitorPrivate::UMApplicationMonitorPrivate(UMApplicationMonitor* a
     , m_loggingThread(nullptr)
     , m_monitorCount(0)
     , m_loggerCount(0)
-    , m_updateInterval{1000, -1, -1}
+    , m_updateInterval{1000, -1, -1, -1, -1, -1}
     , m_flags(UMApplicationMonitor::AllEvents)
 {
     Q_Q(UMApplicationMonitor);
@@ -592,6 +598,36 @@ bool UMApplicationMonitor::logEvent(Event event)
     };
 }
 
+bool UMApplicationMonitor::logJankEvent(QQuickWindow* window, const UMJankEvent& jank)
+{
+    Q_D(UMApplicationMonitor);
+
+    if ((d->m_flags & UMApplicationMonitorPrivate::Logging) && (d->m_flags & JankEvent)) {
+        DASSERT(d->m_loggingThread);
+        UMEvent event;
+        event.type = UMEvent::Jank;
+        event.timeStamp = UMEventUtils::timeStamp();
+        memcpy(&event.jank, &jank, sizeof(UMJankEvent));
+        event.jank.window = 0;
+        d->m_monitorsMutex.lock();
+        for (int i = 0; i < d->m_monitorCount; ++i) {
+            DASSERT(d->m_monitors[i]);
+            if (d->m_monitors[i]->window() == window) {
+                event.jank.window = d->m_monitors[i]->id();
+                break;
+            }
+        }
+        d->m_monitorsMutex.unlock();
+        // Fix up non null-terminated and overflowing strings.
+        event.jank.itemsSize = qBound(1u, jank.itemsSize, quint32(UMJankEvent::maxItemsSize));
+        event.jank.items[event.jank.itemsSize - 1] = '\0';
+        d->m_loggingThread->push(&event);
+        return true;
+    } else {
+        return false;
+    }
+}
+
 void UMApplicationMonitor::setUpdateInterval(UMEvent::Type type, int interval)
 {
     Q_D(UMApplicationMonitor);
@@ -667,15 +703,61 @@ void UMApplicationMonitorPrivate::processTimeout()
     }
 }
 
+void UMApplicationMonitorPrivate::inputEvent(QQuickWindow* window, UMInputEvent::Device device)
+{
+    DASSERT(window);
+
+    if ((m_flags & Logging) && (m_flags & UMApplicationMonitor::InputEvent)) {
+        // The arrival time is taken when the event reaches the application
+        // since the QInputEvent time stamps aren't based on the same clock.
+        const quint64 timeStamp = UMEventUtils::timeStamp();
+        m_monitorsMutex.lock();
+        for (int i = 0; i < m_monitorCount; ++i) {
+            DASSERT(m_monitors[i]);
+            if (m_monitors[i]->window() == window) {
+                m_monitors[i]->setInputEvent(device, timeStamp);
+                break;
+            }
+        }
+        m_monitorsMutex.unlock();
+    }
+}
+
 bool UMApplicationMonitor::eventFilter(QObject* object, QEvent* event)
 {
-    if (event->type() == QEvent::Show) {
+    switch (event->type()) {
+    case QEvent::Show:
         if (QQuickWindow* window = qobject_cast<QQuickWindow*>(object)) {
             Q_D(UMApplicationMonitor);
             d->m_monitorsMutex.lock();
             d->startMonitoring(window);
             d->m_monitorsMutex.unlock();
         }
+        break;
+
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+        // The application filter sees the events delivered to the items too,
+        // only the ones sent to the windows are accounted.
+        if (QQuickWindow* window = qobject_cast<QQuickWindow*>(object)) {
+            d_func()->inputEvent(window, UMInputEvent::Touch);
+        }
+        break;
+
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove:
+        // Mouse events synthesized from touch events are already accounted.
+        if (static_cast<QMouseEvent*>(event)->source() == Qt::MouseEventNotSynthesized) {
+            if (QQuickWindow* window = qobject_cast<QQuickWindow*>(object)) {
+                d_func()->inputEvent(window, UMInputEvent::Mouse);
+            }
+        }
+        break;
+
+    default:
+        break;
     }
     return QObject::eventFilter(object, event);
 }
@@ -708,6 +790,9 @@ WindowMonitor::WindowMonitor(
     , m_id(id)
     , m_flags(flags)
     , m_frameSize(window->width(), window->height())
+    , m_pendingInputTimeStamp(0)
+    , m_pendingInputCount(0)
+    , m_pendingInputDevice(UMInputEvent::Touch)
 {
     DASSERT(applicationMonitor == UMApplicationMonitor::instance());
     DASSERT(m_applicationMonitor);
@@ -736,6 +821,9 @@ WindowMonitor::WindowMonitor(
     memset(&m_frameEvent, 0, sizeof(m_frameEvent));
     m_frameEvent.type = UMEvent::Frame;
     m_frameEvent.frame.window = id;
+    memset(&m_inputEvent, 0, sizeof(m_inputEvent));
+    m_inputEvent.type = UMEvent::Input;
+    m_inputEvent.input.window = id;
 
     if ((flags & UMApplicationMonitorPrivate::Logging)
         && (flags & UMApplicationMonitor::WindowEvent)) {
@@ -814,6 +902,24 @@ void WindowMonitor::windowBeforeSynchronizing()
 {
     if (m_flags & GpuResourcesInitialized) {
         m_sceneGraphTimer.start();
+        if ((m_flags & UMApplicationMonitorPrivate::Logging) &&
+            (m_flags & UMApplicationMonitor::InputEvent)) {
+            // Input received so far is observed by this synchronization pass,
+            // the latency is logged once the frame is swapped.
+            const quint64 timeStamp = UMEventUtils::timeStamp();
+            m_mutex.lock();
+            if (m_pendingInputCount > 0 && m_inputEvent.input.eventCount == 0) {
+                const quint64 latency = timeStamp - m_pendingInputTimeStamp;
+                if (latency <= maxPendingInputAge) {
+                    m_inputEvent.timeStamp = m_pendingInputTimeStamp;
+                    m_inputEvent.input.syncLatency = latency;
+                    m_inputEvent.input.eventCount = m_pendingInputCount;
+                    m_inputEvent.input.device = m_pendingInputDevice;
+                }
+                m_pendingInputCount = 0;
+            }
+            m_mutex.unlock();
+        }
     }
 }
 
@@ -876,6 +982,16 @@ void WindowMonitor::windowFrameSwapped()
             m_frameEvent.timeStamp = UMEventUtils::timeStamp();
             m_loggingThread->push(&m_frameEvent);
         }
+        if (m_inputEvent.input.eventCount > 0) {
+            if ((m_flags & UMApplicationMonitorPrivate::Logging) &&
+                (m_flags & UMApplicationMonitor::InputEvent)) {
+                m_inputEvent.input.frameNumber = m_frameEvent.frame.number;
+                m_inputEvent.input.swapLatency =
+                    UMEventUtils::timeStamp() - m_inputEvent.timeStamp;
+                m_loggingThread->push(&m_inputEvent);
+            }
+            m_inputEvent.input.eventCount = 0;
+        }
     } else {
         initializeGpuResources();  // Get everything ready for the next frame.
         if (m_flags & UMApplicationMonitorPrivate::Overlay) {
@@ -910,3 +1026,19 @@ void WindowMonitor::setProcessEvent(const UMEvent& event)
         m_window->update();
     }
 }
+
+void WindowMonitor::setInputEvent(UMInputEvent::Device device, quint64 timeStamp)
+{
+    m_mutex.lock();
+    if (m_pendingInputCount > 0 && timeStamp - m_pendingInputTimeStamp > maxPendingInputAge) {
+        m_pendingInputCount = 0;  // Stale, restart from that input.
+    }
+    if (m_pendingInputCount == 0) {
+        m_pendingInputTimeStamp = timeStamp;
+        m_pendingInputDevice = device;
+    }
+    if (m_pendingInputCount < 0xffff) {
+        m_pendingInputCount++;
+    }
+    m_mutex.unlock();
+}
@@ -24,6 +24,7 @@
 #include <UbuntuMetrics/events.h>
 #include <UbuntuMetrics/ubuntumetricsglobal.h>
 
+class QQuickWindow;
 class UMApplicationMonitorPrivate;
 
 // Monitor a QtQuick application by automatically tracking QtQuick windows and
@@ -43,8 +44,13 @@ public:
         FrameEvent   = (1 << 2),
         // Allow generic events logging.
         GenericEvent = (1 << 3),
+        // Allow input events logging.
+        InputEvent   = (1 << 4),
+        // Allow jank events logging.
+        JankEvent    = (1 << 5),
         // Allow all events logging.
-        AllEvents    = (ProcessEvent | WindowEvent | FrameEvent | GenericEvent)
+        AllEvents    = (ProcessEvent | WindowEvent | FrameEvent | GenericEvent | InputEvent
+                        | JankEvent)
     };
     Q_DECLARE_FLAGS(LoggingFilters, LoggingFilter)
 
@@ -59,6 +65,10 @@ public:
     // must be running.
     static UMApplicationMonitor* instance() { return self ? self : new UMApplicationMonitor; }
 
+    // Get the UMApplicationMonitor instance without creating it, null if not
+    // instantiated yet.
+    static UMApplicationMonitor* existingInstance() { return self; }
+
     // Render an overlay of real-time metrics on top of each QtQuick frame.
     void setOverlay(bool overlay);
     bool overlay();
@@ -92,6 +102,12 @@ public:
     // event system.
     bool logEvent(Event event);
 
+    // Log a frame which took too long to be rendered by the given window. The
+    // window id is filled in by the application monitor. Can be called from
+    // the QtQuick render threads. Does not log and returns false if logging
+    // is disabled or if the logging filter does not contain JankEvent.
+    bool logJankEvent(QQuickWindow* window, const UMJankEvent& jank);
+
     // Set the time in milliseconds between two updates of events of a given
     // type. -1 to disable updates. Only UMEvent::Process is accepted so far as
     // event type, default value is 1000. Note that when the overlay is enabled,
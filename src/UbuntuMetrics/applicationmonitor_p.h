@@ -69,6 +69,7 @@ public:
     bool hasMonitor(WindowMonitor* monitor);
     void setMonitoringFlags(quint32 flags);
     void processTimeout();
+    void inputEvent(QQuickWindow* window, UMInputEvent::Device device);
 
     UMApplicationMonitor* const q_ptr;
     Q_DECLARE_PUBLIC(UMApplicationMonitor)
@@ -169,7 +170,9 @@ public:
     ~WindowMonitor();
 
     QQuickWindow* window() const { return m_window; }
+    quint32 id() const { return m_id; }
     void setProcessEvent(const UMEvent& event);
+    void setInputEvent(UMInputEvent::Device device, quint64 timeStamp);
 
 private Q_SLOTS:
     void windowSceneGraphInitialized();
@@ -209,6 +212,11 @@ private:
     quint32 m_flags;
     QSize m_frameSize;
     UMEvent m_frameEvent;
+    UMEvent m_inputEvent;
+    // Input received since the last synchronization pass (needs locking).
+    quint64 m_pendingInputTimeStamp;
+    quint16 m_pendingInputCount;
+    UMInputEvent::Device m_pendingInputDevice;
 
     friend class WindowMonitorDeleter;
     friend class WindowMonitorFlagSetter;
@@ -118,9 +118,76 @@ struct UBUNTU_METRICS_EXPORT UMGenericEvent
 };
 Q_STATIC_ASSERT(sizeof(UMGenericEvent) == 112);
 
+struct UBUNTU_METRICS_EXPORT UMInputEvent
+{
+    enum Device { Touch = 0, Mouse = 1, DeviceCount = 2 };
+
+    // The id of the window which received the input.
+    quint32 window;
+
+    // The number of the first frame whose synchronization pass observed the
+    // input. Corresponds to UMFrameEvent::number.
+    quint32 frameNumber;
+
+    // Time in nanoseconds between the arrival of the input and the beginning
+    // of the QtQuick scene graph synchronization pass that observed it.
+    quint64 syncLatency;
+
+    // Time in nanoseconds between the arrival of the input and the end of the
+    // buffer swap of the frame that observed it (input to photon latency).
+    quint64 swapLatency;
+
+    // Number of input events received since the previous frame. The latencies
+    // are measured from the arrival of the first one. Input not observed by a
+    // synchronization pass within 250 ms is not reported.
+    quint16 eventCount;
+
+    // Device which generated the first input event.
+    Device device : 8;
+
+    // The whole struct must take 112 bytes to allow future additions and best
+    // memory alignment, don't forget to update when adding new metrics.
+    quint8 __reserved[/*27 bytes taken,*/ 85 /*bytes free*/];
+};
+Q_STATIC_ASSERT(sizeof(UMInputEvent) == 112);
+
+struct UBUNTU_METRICS_EXPORT UMJankEvent
+{
+    static const quint32 maxItemsSize = 72;
+
+    // The id of the window which rendered the frame, 0 if the window isn't
+    // monitored by the application monitor.
+    quint32 window;
+
+    // Number of items queued for polishing and number of items with contents
+    // whose paint node was updated during the frame.
+    quint16 polishedItemCount;
+    quint16 updatedItemCount;
+
+    // Time in nanoseconds taken by the QtQuick scene graph synchronization
+    // pass.
+    quint64 syncTime;
+
+    // Time in nanoseconds taken by the QtQuick scene graph render pass.
+    quint64 renderTime;
+
+    // Size of the items string (including the null-terminating char).
+    quint32 itemsSize;
+
+    // Null-terminated, comma separated list of the types of the polished and
+    // updated items, the polished ones first. Truncated to maxItemsSize.
+    char items[maxItemsSize];
+
+    // The whole struct must take 112 bytes to allow future additions and best
+    // memory alignment, don't forget to update when adding new metrics.
+    quint8 __reserved[/*100 bytes taken,*/ 12 /*bytes free*/];
+};
+Q_STATIC_ASSERT(sizeof(UMJankEvent) == 112);
+
 struct UBUNTU_METRICS_EXPORT UMEvent
 {
-    enum Type { Process = 0, Window = 1, Frame = 2, Generic = 3, TypeCount = 4 };
+    enum Type { Process = 0, Window = 1, Frame = 2, Generic = 3, Input = 4, Jank = 5,
+                TypeCount = 6 };
 
     // Event type.
     Type type;
@@ -133,6 +200,8 @@ struct UBUNTU_METRICS_EXPORT UMEvent
         UMWindowEvent window;
         UMFrameEvent frame;
         UMGenericEvent generic;
+        UMInputEvent input;
+        UMJankEvent jank;
     };
 };
 Q_STATIC_ASSERT(sizeof(UMEvent) == 128);
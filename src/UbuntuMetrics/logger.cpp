@@ -208,6 +208,60 @@ void UMFileLoggerPrivate::log(const UMEvent& event)
             break;
         }
 
+        case UMEvent::Input: {
+            if (m_flags & Parsable) {
+                m_textStream
+                    << "I "
+                    << event.timeStamp << ' '
+                    << event.input.window << ' '
+                    << event.input.frameNumber << ' '
+                    << event.input.device << ' '
+                    << event.input.eventCount << ' '
+                    << event.input.syncLatency << ' '
+                    << event.input.swapLatency << '\n' << flush;
+            } else {
+                const char* const deviceString[] = { "Touch", "Mouse" };
+                Q_STATIC_ASSERT(ARRAY_SIZE(deviceString) == UMInputEvent::DeviceCount);
+                m_textStream
+                    << (m_flags & Colored ? "\033[34mI\033[00m " : "I ")
+                    << dim << timeString << reset << ' '
+                    << "Win" << dimColon << event.input.window << ' '
+                    << "N" << dimColon << event.input.frameNumber << ' '
+                    << "Device" << dimColon << deviceString[event.input.device] << ' '
+                    << "Count" << dimColon << event.input.eventCount << ' '
+                    << "Sync" << dimColon << event.input.syncLatency / 1000000.0f << "ms "
+                    << "Swap" << dimColon << event.input.swapLatency / 1000000.0f << "ms\n"
+                    << flush;
+            }
+            break;
+        }
+
+        case UMEvent::Jank: {
+            if (m_flags & Parsable) {
+                m_textStream
+                    << "J "
+                    << event.timeStamp << ' '
+                    << event.jank.window << ' '
+                    << event.jank.syncTime << ' '
+                    << event.jank.renderTime << ' '
+                    << event.jank.polishedItemCount << ' '
+                    << event.jank.updatedItemCount << ' '
+                    << event.jank.items << '\n' << flush;
+            } else {
+                m_textStream
+                    << (m_flags & Colored ? "\033[31mJ\033[00m " : "J ")
+                    << dim << timeString << reset << ' '
+                    << "Win" << dimColon << event.jank.window << ' '
+                    << "Sync" << dimColon << event.jank.syncTime / 1000000.0f << "ms "
+                    << "Render" << dimColon << event.jank.renderTime / 1000000.0f << "ms "
+                    << "Polished" << dimColon << event.jank.polishedItemCount << ' '
+                    << "Updated" << dimColon << event.jank.updatedItemCount << ' '
+                    << "Items" << dimColon << '"' << event.jank.items << '"'
+                    << '\n' << flush;
+            }
+            break;
+        }
+
         default:
             DNOT_REACHED();
             break;
@@ -316,6 +370,34 @@ void UMLTTNGLogger::log(const UMEvent& event)
             break;
         }
 
+        case UMEvent::Input: {
+            const char* deviceString[] = { "Touch", "Mouse" };
+            Q_STATIC_ASSERT(ARRAY_SIZE(deviceString) == UMInputEvent::DeviceCount);
+            UMLTTNGInputEvent inputEvent = {
+                .device = deviceString[event.input.device],
+                .window = event.input.window,
+                .frameNumber = event.input.frameNumber,
+                .eventCount = event.input.eventCount,
+                .syncLatency = event.input.syncLatency * 0.000001f,
+                .swapLatency = event.input.swapLatency * 0.000001f
+            };
+            m_plugin->logInputEvent(&inputEvent);
+            break;
+        }
+
+        case UMEvent::Jank: {
+            UMLTTNGJankEvent jankEvent = {
+                .items = event.jank.items,
+                .window = event.jank.window,
+                .polishedItemCount = event.jank.polishedItemCount,
+                .updatedItemCount = event.jank.updatedItemCount,
+                .syncTime = event.jank.syncTime * 0.000001f,
+                .renderTime = event.jank.renderTime * 0.000001f
+            };
+            m_plugin->logJankEvent(&jankEvent);
+            break;
+        }
+
         default:
             DNOT_REACHED();
             break;
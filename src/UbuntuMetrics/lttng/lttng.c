@@ -38,9 +38,21 @@ static void logGenericEvent(UMLTTNGGenericEvent* event)
     tracepoint(UbuntuMetrics, generic, event);
 }
 
+static void logInputEvent(UMLTTNGInputEvent* event)
+{
+    tracepoint(UbuntuMetrics, input, event);
+}
+
+static void logJankEvent(UMLTTNGJankEvent* event)
+{
+    tracepoint(UbuntuMetrics, jank, event);
+}
+
 const struct UMLTTNGPlugin umLttngPlugin = {
     &logProcessEvent,
     &logFrameEvent,
     &logWindowEvent,
     &logGenericEvent,
+    &logInputEvent,
+    &logJankEvent,
 };
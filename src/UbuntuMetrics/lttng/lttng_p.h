@@ -25,12 +25,16 @@ typedef struct _UMLTTNGProcessEvent UMLTTNGProcessEvent;
 typedef struct _UMLTTNGFrameEvent UMLTTNGFrameEvent;
 typedef struct _UMLTTNGWindowEvent UMLTTNGWindowEvent;
 typedef struct _UMLTTNGGenericEvent UMLTTNGGenericEvent;
+typedef struct _UMLTTNGInputEvent UMLTTNGInputEvent;
+typedef struct _UMLTTNGJankEvent UMLTTNGJankEvent;
 
 struct UMLTTNGPlugin {
     void (*logProcessEvent)(UMLTTNGProcessEvent*);
     void (*logFrameEvent)(UMLTTNGFrameEvent*);
     void (*logWindowEvent)(UMLTTNGWindowEvent*);
     void (*logGenericEvent)(UMLTTNGGenericEvent*);
+    void (*logInputEvent)(UMLTTNGInputEvent*);
+    void (*logJankEvent)(UMLTTNGJankEvent*);
 };
 
 struct _UMLTTNGProcessEvent {
@@ -65,4 +69,22 @@ struct _UMLTTNGGenericEvent {
     char string[64];
 };
 
+struct _UMLTTNGInputEvent {
+    const char* device;
+    uint32_t window;
+    uint32_t frameNumber;
+    uint16_t eventCount;
+    float syncLatency;
+    float swapLatency;
+};
+
+struct _UMLTTNGJankEvent {
+    const char* items;
+    uint32_t window;
+    uint16_t polishedItemCount;
+    uint16_t updatedItemCount;
+    float syncTime;
+    float renderTime;
+};
+
 #endif  // LTTNG_P_H
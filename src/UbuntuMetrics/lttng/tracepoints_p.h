@@ -79,5 +79,35 @@ TRACEPOINT_EVENT(
     )
 )
 
+TRACEPOINT_EVENT(
+    UbuntuMetrics, input,
+    TP_ARGS(
+        UMLTTNGInputEvent*, inputEvent
+    ),
+    TP_FIELDS(
+        ctf_integer(uint32_t, window, inputEvent->window)
+        ctf_integer(uint32_t, frame_number, inputEvent->frameNumber)
+        ctf_string(device, inputEvent->device)
+        ctf_integer(uint16_t, event_count, inputEvent->eventCount)
+        ctf_float(float, sync_latency, inputEvent->syncLatency)
+        ctf_float(float, swap_latency, inputEvent->swapLatency)
+    )
+)
+
+TRACEPOINT_EVENT(
+    UbuntuMetrics, jank,
+    TP_ARGS(
+        UMLTTNGJankEvent*, jankEvent
+    ),
+    TP_FIELDS(
+        ctf_integer(uint32_t, window, jankEvent->window)
+        ctf_float(float, sync_time, jankEvent->syncTime)
+        ctf_float(float, render_time, jankEvent->renderTime)
+        ctf_integer(uint16_t, polished_item_count, jankEvent->polishedItemCount)
+        ctf_integer(uint16_t, updated_item_count, jankEvent->updatedItemCount)
+        ctf_string(items, jankEvent->items)
+    )
+)
+
 #endif  // TRACEPOINTS_P_H
 #include <lttng/tracepoint-event.h>
@@ -179,6 +179,7 @@ SOURCES += \
     $$PWD/splitview.cpp \
     $$PWD/splitviewlayout.cpp \
     $$PWD/statesaverbackend_p.cpp \
+    $$PWD/timeutils.cpp \
     $$PWD/tree.cpp \
     $$PWD/ubuntutoolkitmodule.cpp \
     $$PWD/ucabstractbutton.cpp \
@@ -32,6 +32,13 @@
 #include "ucalarm_p_p.h"
 
 static const QString alarmDatabase = QStringLiteral("%1/alarms.json");
+// changes since the last database snapshot, one JSON object per line
+static const QString alarmJournal = QStringLiteral("%1/alarms.journal");
+// the journal is compacted into the database above this many entries
+static const int journalCompactionLimit = 100;
+// change sets bigger than this reset the alarm model instead of notifying
+// each alarm change
+static const int bulkChangeLimit = 10;
 
 // The main alarm manager engine used from Saucy onwards is EDS (Evolution Data
 // Server) based. Any previous release uses the generic "memory" manager engine
@@ -388,6 +395,7 @@ AlarmsAdapter::AlarmsAdapter(AlarmManager *qq)
     : QObject(qq)
     , AlarmManagerPrivate(qq)
     , manager(0)
+    , journalEntries(0)
 {
     // register QOrganizerItemId comparators so QVariant == operator can compare them
     QMetaType::registerComparators<QOrganizerItemId>();
@@ -425,27 +433,133 @@ AlarmsAdapter::AlarmsAdapter(AlarmManager *qq)
     }
 }
 
+// organizer changes are queued and their items fetched in one request
 void AlarmsAdapter::alarmOperation(QList<QPair<QOrganizerItemId,QOrganizerManager::Operation> > list)
 {
-    typedef QPair<QOrganizerItemId,QOrganizerManager::Operation> OperationPair;
-    Q_FOREACH(const OperationPair &op, list) {
+    pendingChanges.append(list);
+    fetchChanges();
+}
+
+void AlarmsAdapter::fetchChanges()
+{
+    if (pendingChanges.isEmpty()
+            || (changeRequest && changeRequest->isActive())
+            || (fetchRequest && fetchRequest->isActive())) {
+        // either nothing to do, or will be called when the ongoing request completes
+        return;
+    }
+    fetchedChanges = pendingChanges;
+    pendingChanges.clear();
+
+    QSet<QOrganizerItemId> idSet;
+    QList<QOrganizerItemId> ids;
+    Q_FOREACH(const Operation &op, fetchedChanges) {
+        if (op.second != QOrganizerManager::Remove && !idSet.contains(op.first)) {
+            idSet << op.first;
+            ids << op.first;
+        }
+    }
+    if (ids.isEmpty()) {
+        // removals only, nothing to fetch
+        QList<Operation> changes = fetchedChanges;
+        fetchedChanges.clear();
+        applyChanges(changes, QHash<QOrganizerItemId, QOrganizerTodo>());
+        return;
+    }
+
+    if (!changeRequest) {
+        changeRequest = new QOrganizerItemFetchByIdRequest(this);
+        changeRequest->setManager(manager);
+        QObject::connect(changeRequest, SIGNAL(stateChanged(QOrganizerAbstractRequest::State)), this, SLOT(completeFetchChanges()));
+    }
+    changeRequest->setIds(ids);
+    changeRequest->start();
+}
+
+void AlarmsAdapter::completeFetchChanges()
+{
+    if (changeRequest->state() != QOrganizerAbstractRequest::FinishedState) {
+        return;
+    }
+
+    // map each fetched ID to its todo event; occurrences are resolved to their
+    // parent events, which are fetched together
+    QHash<QOrganizerItemId, QOrganizerTodo> events;
+    QHash<QOrganizerItemId, QOrganizerItemId> occurrences;
+    Q_FOREACH(const QOrganizerItem &item, changeRequest->items()) {
+        if (item.type() == QOrganizerItemType::TypeTodoOccurrence) {
+            QOrganizerTodoOccurrence occurrence = static_cast<QOrganizerTodoOccurrence>(item);
+            occurrences.insert(item.id(), occurrence.parentId());
+        } else if (item.type() == QOrganizerItemType::TypeTodo) {
+            events.insert(item.id(), static_cast<QOrganizerTodo>(item));
+        }
+    }
+    if (!occurrences.isEmpty()) {
+        QList<QOrganizerItemId> parentIds;
+        Q_FOREACH(const QOrganizerItemId &parentId, occurrences.values().toSet()) {
+            if (!events.contains(parentId)) {
+                parentIds << parentId;
+            }
+        }
+        if (!parentIds.isEmpty()) {
+            Q_FOREACH(const QOrganizerItem &item, manager->items(parentIds)) {
+                if (item.type() == QOrganizerItemType::TypeTodo) {
+                    events.insert(item.id(), static_cast<QOrganizerTodo>(item));
+                }
+            }
+        }
+        QHash<QOrganizerItemId, QOrganizerItemId>::const_iterator i;
+        for (i = occurrences.constBegin(); i != occurrences.constEnd(); ++i) {
+            if (events.contains(i.value())) {
+                events.insert(i.key(), events.value(i.value()));
+            }
+        }
+    }
+
+    QList<Operation> changes = fetchedChanges;
+    fetchedChanges.clear();
+    applyChanges(changes, events);
+
+    // continue with the changes arrived meanwhile
+    fetchChanges();
+}
+
+void AlarmsAdapter::applyChanges(const QList<Operation> &changes, const QHash<QOrganizerItemId, QOrganizerTodo> &events)
+{
+    bool bulk = changes.count() > bulkChangeLimit;
+    if (bulk) {
+        Q_EMIT q_ptr->alarmsRefreshStarted();
+    }
+    QList<Operation> journal;
+    Q_FOREACH(const Operation &op, changes) {
         switch (op.second) {
         case QOrganizerManager::Add: {
-            insertAlarm(op.first);
+            QOrganizerTodo event = events.value(op.first);
+            if (insertAlarm(event, !bulk)) {
+                journal << Operation(event.id(), op.second);
+            }
             break;
         }
         case QOrganizerManager::Change: {
-            updateAlarm(op.first);
+            QOrganizerTodo event = events.value(op.first);
+            if (updateAlarm(event, !bulk)) {
+                journal << Operation(event.id(), op.second);
+            }
             break;
         }
         case QOrganizerManager::Remove: {
-            removeAlarm(op.first);
-            // save alarm data
+            if (removeAlarm(op.first, !bulk)) {
+                journal << op;
+            }
             break;
         }
         }
     }
-    saveAlarms();
+    if (bulk) {
+        Q_EMIT q_ptr->alarmsRefreshed();
+    }
+    // save alarm data
+    journalAlarms(journal);
 }
 
 void AlarmsAdapter::init()
@@ -468,21 +582,93 @@ UCAlarmPrivate * AlarmsAdapter::createAlarmData(UCAlarm *alarm)
     return new AlarmDataAdapter(alarm);
 }
 
+// JSON representation of an alarm in the fallback manager database
+static QJsonObject alarmToJson(const UCAlarm *alarm)
+{
+    QJsonObject object;
+    object[QStringLiteral("id")] = alarm->cookie().value<QOrganizerItemId>().toString();
+    object[QStringLiteral("message")] = alarm->message();
+    object[QStringLiteral("date")] = alarm->date().toString();
+    object[QStringLiteral("sound")] = alarm->sound().toString();
+    object[QStringLiteral("type")] = QJsonValue(alarm->type());
+    object[QStringLiteral("days")] = QJsonValue(alarm->daysOfWeek());
+    object[QStringLiteral("enabled")] = QJsonValue(alarm->enabled());
+    return object;
+}
+
+// writes the database snapshot and drops the journal
+static void writeDatabase(const QJsonArray &data)
+{
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
+    if (!dir.exists()) {
+        dir.mkpath(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
+    }
+    QFile file(alarmDatabase.arg(dir.path()));
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        return;
+    }
+    QJsonDocument document(data);
+    file.write(document.toJson());
+    file.close();
+    QFile::remove(alarmJournal.arg(dir.path()));
+}
+
 // load fallback manager data
 void AlarmsAdapter::loadAlarms()
 {
     if (manager->managerName() != alarmManagerFallback) {
         return;
     }
-    QFile file(alarmDatabase.arg(QStandardPaths::writableLocation(QStandardPaths::DataLocation)));
-    if (!file.open(QFile::ReadOnly)) {
+    QString path = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    QFile file(alarmDatabase.arg(path));
+    QFile journal(alarmJournal.arg(path));
+    if (!file.exists() && !journal.exists()) {
         return;
     }
-    QByteArray data = file.readAll();
-    QJsonDocument document(QJsonDocument::fromJson(data));
-    QJsonArray array = document.array();
-    for (int i = 0; i < array.size(); i++) {
-        QJsonObject object = array[i].toObject();
+
+    // read the snapshot and replay the journal on top of it; the IDs are the
+    // ones from the session the entries were written in
+    QStringList keys;
+    QHash<QString, QJsonObject> objects;
+    if (file.open(QFile::ReadOnly)) {
+        QJsonArray array = QJsonDocument::fromJson(file.readAll()).array();
+        for (int i = 0; i < array.size(); i++) {
+            QJsonObject object = array[i].toObject();
+            QString key = object[QStringLiteral("id")].toString();
+            if (key.isEmpty()) {
+                // database written before journaling
+                key = QString::number(i);
+            }
+            keys << key;
+            objects.insert(key, object);
+        }
+        file.close();
+    }
+    if (journal.open(QFile::ReadOnly)) {
+        while (!journal.atEnd()) {
+            QJsonObject object = QJsonDocument::fromJson(journal.readLine()).object();
+            QString key = object[QStringLiteral("id")].toString();
+            if (key.isEmpty()) {
+                continue;
+            }
+            if (object[QStringLiteral("operation")].toString() == QStringLiteral("remove")) {
+                objects.remove(key);
+            } else {
+                if (!objects.contains(key)) {
+                    keys << key;
+                }
+                objects.insert(key, object);
+            }
+        }
+        journal.close();
+    }
+
+    QJsonArray data;
+    Q_FOREACH(const QString &key, keys) {
+        if (!objects.contains(key)) {
+            continue;
+        }
+        QJsonObject object = objects.value(key);
 
         // use UCAlarm to save store JSON data
         UCAlarm alarm;
@@ -499,40 +685,57 @@ void AlarmsAdapter::loadAlarms()
         pAlarm->checkAlarm();
         QOrganizerTodo event = pAlarm->data();
         manager->saveItem(&event);
+        object = alarmToJson(&alarm);
+        object[QStringLiteral("id")] = event.id().toString();
+        data.append(object);
     }
-    file.close();
+    // compact with the IDs of this session
+    writeDatabase(data);
 }
 
-// save fallback manager data only
+// save fallback manager data only, compacts the journal
 void AlarmsAdapter::saveAlarms()
 {
     if (manager->managerName() != alarmManagerFallback) {
         return;
     }
-    QDir dir(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
-    if (!dir.exists()) {
-        dir.mkpath(QStandardPaths::writableLocation(QStandardPaths::DataLocation));
+    QJsonArray data;
+    for(int i = 0; i < alarmList.count(); i++) {
+        data.append(alarmToJson(alarmList[i]));
     }
-    QFile file(alarmDatabase.arg(dir.path()));
-    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+    writeDatabase(data);
+    journalEntries = 0;
+}
+
+// append the alarm changes to the fallback manager journal
+void AlarmsAdapter::journalAlarms(const QList<Operation> &operations)
+{
+    if (operations.isEmpty() || manager->managerName() != alarmManagerFallback) {
         return;
     }
-    QJsonArray data;
-    for(int i = 0; i < alarmList.count(); i++) {
-        // create an UCAlarm and set its event to ease conversions
-        const UCAlarm *alarm = alarmList[i];
+    journalEntries += operations.count();
+    QString path = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    if (journalEntries > journalCompactionLimit || !QFile::exists(alarmDatabase.arg(path))) {
+        saveAlarms();
+        return;
+    }
+    QFile file(alarmJournal.arg(path));
+    if (!file.open(QFile::WriteOnly | QFile::Append)) {
+        return;
+    }
+    Q_FOREACH(const Operation &op, operations) {
         QJsonObject object;
-        object[QStringLiteral("message")] = alarm->message();
-        object[QStringLiteral("date")] = alarm->date().toString();
-        object[QStringLiteral("sound")] = alarm->sound().toString();
-        object[QStringLiteral("type")] = QJsonValue(alarm->type());
-        object[QStringLiteral("days")] = QJsonValue(alarm->daysOfWeek());
-        object[QStringLiteral("enabled")] = QJsonValue(alarm->enabled());
-        data.append(object);
-
+        int index = (op.second != QOrganizerManager::Remove) ? alarmList.indexOf(op.first) : -1;
+        if (index >= 0) {
+            object = alarmToJson(alarmList[index]);
+            object[QStringLiteral("operation")] = QStringLiteral("save");
+        } else {
+            object[QStringLiteral("id")] = op.first.toString();
+            object[QStringLiteral("operation")] = QStringLiteral("remove");
+        }
+        file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+        file.write("\n");
     }
-    QJsonDocument document(data);
-    file.write(document.toJson());
     file.close();
 }
 
@@ -668,32 +871,15 @@ bool AlarmsAdapter::findAlarm(const UCAlarm &alarm, const QVariant &cookie) cons
     return false;
 }
 
-// returns a todo event from an ID, which can be an occurence
-QOrganizerTodo AlarmsAdapter::todoItem(const QOrganizerItemId &id)
+// inserts the alarm event, returns true if the alarm list was changed
+bool AlarmsAdapter::insertAlarm(const QOrganizerTodo &event, bool notify)
 {
-    QOrganizerTodo event;
-    if (!id.isNull()) {
-        const QOrganizerItem item = manager->item(id);
-        if (item.type() == QOrganizerItemType::TypeTodoOccurrence) {
-            QOrganizerTodoOccurrence occurrence = static_cast<QOrganizerTodoOccurrence>(item);
-            QOrganizerItemId eventId = occurrence.parentId();
-            event = static_cast<QOrganizerTodo>(manager->item(eventId));
-        } else if (item.type() == QOrganizerItemType::TypeTodo){
-            event = static_cast<QOrganizerTodo>(item);
-        }
-    }
-    return event;
-}
-
-void AlarmsAdapter::insertAlarm(const QOrganizerItemId &id)
-{
-    QOrganizerTodo event = todoItem(id);
     if (event.isEmpty()) {
-        return;
+        return false;
     }
     // if we have the alarm registered, leave
     if (alarmList.indexOf(event.id()) >= 0) {
-        return;
+        return false;
     }
     // use UCAlarm to fix date
     UCAlarm alarm;
@@ -703,23 +889,25 @@ void AlarmsAdapter::insertAlarm(const QOrganizerItemId &id)
 
     // insert and get the index
     int index = alarmList.insert(alarm);
-    Q_EMIT q_ptr->alarmInsertStarted(index);
-    Q_EMIT q_ptr->alarmInsertFinished();
+    if (notify) {
+        Q_EMIT q_ptr->alarmInsertStarted(index);
+        Q_EMIT q_ptr->alarmInsertFinished();
+    }
+    return true;
 }
 
-// updates an alarm and returns the index, -1 on error
-void AlarmsAdapter::updateAlarm(const QOrganizerItemId &id)
+// updates an alarm, returns true if the alarm list was changed
+bool AlarmsAdapter::updateAlarm(const QOrganizerTodo &event, bool notify)
 {
-    QOrganizerTodo event = todoItem(id);
     if (event.isEmpty()) {
-        return;
+        return false;
     }
     // update alarm data
     int index = alarmList.indexOf(event.id());
     if (index < 0) {
         // it can be that the organizer item ID is not an alarm or it is an occurrence of
         // an organizer event
-        return;
+        return false;
     }
     // use UCAlarm to ease conversions
     UCAlarm alarm;
@@ -727,30 +915,39 @@ void AlarmsAdapter::updateAlarm(const QOrganizerItemId &id)
     pAlarm->setData(event);
     adjustAlarmOccurrence(*pAlarm);
     int newIndex = alarmList.update(index, alarm);
+    if (!notify) {
+        return true;
+    }
     if (newIndex == index) {
         Q_EMIT q_ptr->alarmUpdated(index);
     } else {
         Q_EMIT q_ptr->alarmMoveStarted(index, newIndex);
         Q_EMIT q_ptr->alarmMoveFinished();
     }
+    return true;
 }
 
-// removes an alarm from the list
-void AlarmsAdapter::removeAlarm(const QOrganizerItemId &id)
+// removes an alarm from the list, returns true if the alarm list was changed
+bool AlarmsAdapter::removeAlarm(const QOrganizerItemId &id, bool notify)
 {
     if (id.isNull()) {
-        return;
+        return false;
     }
     int index = alarmList.indexOf(id);
     if (index < 0) {
         // this may be an item we don't handle, organizer manager may report us
         // other calendar event removals as well.
-        return;
+        return false;
     }
     // emit removal start
-    Q_EMIT q_ptr->alarmRemoveStarted(index);
+    if (notify) {
+        Q_EMIT q_ptr->alarmRemoveStarted(index);
+    }
     alarmList.removeAt(index);
-    Q_EMIT q_ptr->alarmRemoveFinished();
+    if (notify) {
+        Q_EMIT q_ptr->alarmRemoveFinished();
+    }
+    return true;
 }
 
 void AlarmsAdapter::completeFetchAlarms()
@@ -788,6 +985,9 @@ void AlarmsAdapter::completeFetchAlarms()
 
     completed = true;
     Q_EMIT q_ptr->alarmsRefreshed();
+
+    // apply the organizer changes arrived during the fetch
+    fetchChanges();
 }
 
 void AlarmsAdapter::adjustAlarmOccurrence(AlarmDataAdapter &alarm)
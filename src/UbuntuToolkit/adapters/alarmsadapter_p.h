@@ -19,9 +19,13 @@
 #ifndef ALARMSADAPTER_P_H
 #define ALARMSADAPTER_P_H
 
+#include <algorithm>
+
+#include <QtCore/QVector>
 #include <QtOrganizer/QOrganizerManager>
 #include <QtOrganizer/QOrganizerAbstractRequest>
 #include <QtOrganizer/QOrganizerItemFetchRequest>
+#include <QtOrganizer/QOrganizerItemFetchByIdRequest>
 #include <QtOrganizer/QOrganizerTodo>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
@@ -85,7 +89,8 @@ protected:
     void startOperation(UCAlarm::Operation operation, const char *completionSlot);
 };
 
-// list of alarms
+// list of alarms, ordered by occurrence date + event id, ascending; positional
+// access is O(1), id lookup is O(log n)
 class AlarmList
 {
 public:
@@ -93,7 +98,9 @@ public:
 
     void clear()
     {
-        qDeleteAll(data);
+        for (int i = 0; i < data.count(); i++) {
+            delete data[i].alarm;
+        }
         data.clear();
         idHash.clear();
     }
@@ -103,8 +110,7 @@ public:
     }
     const UCAlarm *operator[](int index) const
     {
-        QPair<QDateTime, QOrganizerItemId> key = data.keys()[index];
-        return data.value(key);
+        return data[index].alarm;
     }
     // update event at index, returns the new event index
     int update(int index, const UCAlarm &alarm)
@@ -115,29 +121,25 @@ public:
         AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(AlarmDataAdapter::get(oldAlarm));
         pAlarm->copyAlarmData(alarm);
         // and insert it back
-        QDateTime dt = oldAlarm->date();
-        QOrganizerItemId id = oldAlarm->cookie().value<QOrganizerItemId>();
-        idHash.insert(id, dt);
-        data.insert(QPair<QDateTime, QOrganizerItemId>(dt, id), oldAlarm);
-        return indexOf(id);
+        return insertEntry(oldAlarm);
     }
     // insert an alarm event into the list
     int insert(const UCAlarm &alarm)
     {
-        QDateTime dt = alarm.date();
-        QOrganizerItemId id = alarm.cookie().value<QOrganizerItemId>();
-        idHash.insert(id, dt);
         UCAlarm *newAlarm = new UCAlarm;
         UCAlarmPrivate::get(newAlarm)->copyAlarmData(alarm);
-        data.insert(QPair<QDateTime, QOrganizerItemId>(dt, id), newAlarm);
-        return indexOf(id);
+        return insertEntry(newAlarm);
     }
     // returns the index of the alarm matching the id, -1 on error
-    int indexOf(const QOrganizerItemId &id)
+    int indexOf(const QOrganizerItemId &id) const
     {
-        QDateTime dt = idHash.value(id);
-        QPair<QDateTime, QOrganizerItemId> key(dt, id);
-        return data.keys().indexOf(key);
+        QHash<QOrganizerItemId, QDateTime>::const_iterator i = idHash.constFind(id);
+        if (i == idHash.constEnd()) {
+            return -1;
+        }
+        Key key(i.value(), id);
+        QVector<Entry>::const_iterator pos = std::lower_bound(data.constBegin(), data.constEnd(), key);
+        return (pos != data.constEnd() && pos->key == key) ? int(pos - data.constBegin()) : -1;
     }
     // remove alarm at index
     void removeAt(int index)
@@ -147,19 +149,49 @@ public:
     }
 
 protected:
+    typedef QPair<QDateTime, QOrganizerItemId> Key;
+    struct Entry
+    {
+        Key key;
+        UCAlarm *alarm;
+
+        bool operator<(const Key &other) const
+        {
+            return key < other;
+        }
+    };
+
     // removes alarm data at index and returns the alarm pointer
     UCAlarm *takeAt(int index)
     {
-        QPair<QDateTime, QOrganizerItemId> key = data.keys()[index];
-        UCAlarm *alarm = data.take(key);
-        idHash.remove(key.second);
-        return alarm;
+        Entry entry = data[index];
+        data.remove(index);
+        idHash.remove(entry.key.second);
+        return entry.alarm;
+    }
+    // inserts the alarm at its sorted position, returns the index of the alarm
+    int insertEntry(UCAlarm *alarm)
+    {
+        Entry entry;
+        entry.key = Key(alarm->date(), alarm->cookie().value<QOrganizerItemId>());
+        entry.alarm = alarm;
+        idHash.insert(entry.key.second, entry.key.first);
+        QVector<Entry>::iterator pos = std::lower_bound(data.begin(), data.end(), entry.key);
+        if (pos != data.end() && pos->key == entry.key) {
+            // same event already listed, replace it
+            delete pos->alarm;
+            pos->alarm = alarm;
+            return int(pos - data.begin());
+        }
+        int index = int(pos - data.begin());
+        data.insert(index, entry);
+        return index;
     }
 
 private:
-    // ordered map by occurrence date + event id, ascending
-    QMap< QPair<QDateTime, QOrganizerItemId>, UCAlarm*> data;
-    // alarms ordered based on even id
+    // sorted by occurrence date + event id, ascending
+    QVector<Entry> data;
+    // occurrence dates of the alarms, keyed by event id
     QHash<QOrganizerItemId, QDateTime> idHash;
 };
 
@@ -190,25 +222,36 @@ public:
     bool findAlarm(const UCAlarm &alarm, const QVariant &cookie) const override;
     void adjustAlarmOccurrence(AlarmDataAdapter &alarm);
 
+    typedef QPair<QOrganizerItemId,QOrganizerManager::Operation> Operation;
+
     void loadAlarms();
     void saveAlarms();
+    void journalAlarms(const QList<Operation> &operations);
 
     bool verifyChange(UCAlarm *alarm, AlarmManager::Change change, const QVariant &value) override;
     UCAlarmPrivate *createAlarmData(UCAlarm *alarm) override;
 
-    void insertAlarm(const QOrganizerItemId &id);
-    void updateAlarm(const QOrganizerItemId &id);
-    void removeAlarm(const QOrganizerItemId &id);
+    bool insertAlarm(const QOrganizerTodo &event, bool notify);
+    bool updateAlarm(const QOrganizerTodo &event, bool notify);
+    bool removeAlarm(const QOrganizerItemId &id, bool notify);
 
 private Q_SLOTS:
     void completeFetchAlarms();
     bool fetchAlarms() override;
     void alarmOperation(QList<QPair<QOrganizerItemId,QOrganizerManager::Operation> >);
+    void completeFetchChanges();
 
 protected:
     QPointer<QOrganizerItemFetchRequest> fetchRequest;
+    QPointer<QOrganizerItemFetchByIdRequest> changeRequest;
+    // organizer changes waiting to be fetched, and the ones being fetched
+    QList<Operation> pendingChanges;
+    QList<Operation> fetchedChanges;
     AlarmList alarmList;
-    QOrganizerTodo todoItem(const QOrganizerItemId &id);
+    int journalEntries;
+
+    void fetchChanges();
+    void applyChanges(const QList<Operation> &changes, const QHash<QOrganizerItemId, QOrganizerTodo> &events);
 };
 
 UT_NAMESPACE_END
@@ -19,6 +19,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <QtCore/QMetaProperty>
 #include <QtDBus/QDBusReply>
 #include <QtQml/QQmlInfo>
 
@@ -38,7 +39,6 @@ DBusServiceProperties::DBusServiceProperties(UCServiceProperties *qq)
     : UCServicePropertiesPrivate(qq)
     , connection(QStringLiteral(""))
     , watcher(0)
-    , iface(0)
 {
 }
 
@@ -46,8 +46,6 @@ bool DBusServiceProperties::init()
 {
     // crear previous connections
     setStatus(UCServiceProperties::Inactive);
-    delete iface;
-    iface = 0;
     delete watcher;
     watcher = 0;
     setError(QString());
@@ -80,13 +78,6 @@ bool DBusServiceProperties::init()
     Q_Q(UCServiceProperties);
     // connect dbus watcher to catch OwnerChanged
     watcher = new QDBusServiceWatcher(service, connection, QDBusServiceWatcher::WatchForOwnerChange, q);
-    // connect interface
-    iface = new QDBusInterface(service, path, interface, connection, q);
-    if (!iface->isValid()) {
-        setStatus(UCServiceProperties::ConnectionError);
-        setError(iface->lastError().message());
-        return false;
-    }
     // connect watcher to get owner changes
     QObject::connect(watcher, SIGNAL(serviceOwnerChanged(QString,QString,QString)),
                      this, SLOT(changeServiceOwner(QString,QString,QString)));
@@ -95,15 +86,17 @@ bool DBusServiceProperties::init()
 
 /*
  * Connect dbus signal identified by (service, path, iface, name) quaduple to a
- * slot to receive property changes.
+ * slot to receive property changes. The calls are composed as plain messages,
+ * QDBusInterface would introspect the service synchronously.
  */
 bool DBusServiceProperties::setupInterface()
 {
-    QDBusReply<QDBusObjectPath> dbusObjectPath =
-        iface->call(QStringLiteral("FindUserById"), qlonglong(getuid()));
+    QDBusMessage findUser = QDBusMessage::createMethodCall(service, path, interface, QStringLiteral("FindUserById"));
+    findUser << qlonglong(getuid());
+    QDBusReply<QDBusObjectPath> dbusObjectPath = connection.call(findUser);
     if (dbusObjectPath.isValid()) {
         objectPath = dbusObjectPath.value().path();
-        iface->connection().connect(
+        connection.connect(
             service,
             objectPath,
             dbusInterface,
@@ -118,12 +111,34 @@ bool DBusServiceProperties::setupInterface()
     return false;
 }
 
+/*
+ * Composes a call to the properties interface of the object resolved.
+ */
+QDBusMessage DBusServiceProperties::propertiesCall(const QString &method)
+{
+    return QDBusMessage::createMethodCall(service, objectPath, dbusInterface, method);
+}
+
+/*
+ * Reads all the property values of the adaptorInterface with a single
+ * asynchronous call.
+ */
 bool DBusServiceProperties::fetchPropertyValues()
 {
-    scannedProperties = properties;
-    Q_FOREACH(QString property, properties) {
-        readProperty(property);
+    if ((status < UCServiceProperties::Synchronizing) || objectPath.isEmpty()) {
+        return false;
     }
+    Q_Q(UCServiceProperties);
+    QDBusMessage getAll = propertiesCall(QStringLiteral("GetAll"));
+    getAll << adaptor;
+    QDBusPendingCall pending = connection.asyncCall(getAll);
+    if (pending.isError()) {
+        warning(pending.error().message());
+        return false;
+    }
+    QDBusPendingCallWatcher *callWatcher = new QDBusPendingCallWatcher(pending, q);
+    QObject::connect(callWatcher, SIGNAL(finished(QDBusPendingCallWatcher*)),
+                     this, SLOT(readAllFinished(QDBusPendingCallWatcher*)));
     return true;
 }
 
@@ -136,15 +151,9 @@ bool DBusServiceProperties::readProperty(const QString &property)
         return false;
     }
     Q_Q(UCServiceProperties);
-    QDBusInterface readIFace(iface->interface(), objectPath, dbusInterface, connection);
-    if (!readIFace.isValid()) {
-        // report invalid interface only if the property's first letter was with capital one!
-        if (property[0].isUpper()) {
-            warning(readIFace.lastError().message());
-        }
-        return false;
-    }
-    QDBusPendingCall pending = readIFace.asyncCall(QStringLiteral("Get"), adaptor, property);
+    QDBusMessage get = propertiesCall(QStringLiteral("Get"));
+    get << adaptor << property;
+    QDBusPendingCall pending = connection.asyncCall(get);
     if (pending.isError()) {
         warning(pending.error().message());
         return false;
@@ -166,25 +175,75 @@ bool DBusServiceProperties::testProperty(const QString &property, const QVariant
     if (objectPath.isEmpty()) {
         return false;
     }
-    QDBusInterface writeIFace(iface->interface(), objectPath, dbusInterface, connection);
-    if (!writeIFace.isValid()) {
-        // invalid interface
-        return false;
-    }
-    QDBusMessage msg = writeIFace.call(
-        QStringLiteral("Set"), adaptor, property, QVariant::fromValue(QDBusVariant(value)));
+    QDBusMessage set = propertiesCall(QStringLiteral("Set"));
+    set << adaptor << property << QVariant::fromValue(QDBusVariant(value));
+    QDBusMessage msg = connection.call(set);
     return msg.type() == QDBusMessage::ReplyMessage;
 }
 
+/*
+ * Updates the watched properties from the values in one pass.
+ */
+void DBusServiceProperties::setPropertyValues(const QVariantMap &values)
+{
+    Q_Q(UCServiceProperties);
+    const QMetaObject *mo = q->metaObject();
+    for (QVariantMap::const_iterator i = values.constBegin(); i != values.constEnd(); ++i) {
+        if (!properties.contains(i.key())) {
+            continue;
+        }
+        // make sure we have lower case when the property value is updated
+        QString property(i.key());
+        property[0] = property[0].toLower();
+        int index = mo->indexOfProperty(property.toLocal8Bit().constData());
+        if (index >= 0) {
+            mo->property(index).write(q, i.value());
+        }
+    }
+}
+
+/*
+ * Slot called when the async read of all properties finishes.
+ */
+void DBusServiceProperties::readAllFinished(QDBusPendingCallWatcher *call)
+{
+    QDBusPendingReply<QVariantMap> reply = *call;
+    if (reply.isError()) {
+        // nothing to watch on the adaptor
+        properties.clear();
+        warning(reply.error().message());
+    } else {
+        QVariantMap values = reply.value();
+        // remove the properties the service has not, report only those with
+        // capital first letter
+        Q_FOREACH(const QString &property, properties) {
+            if (values.contains(property)) {
+                continue;
+            }
+            properties.removeAll(property);
+            if (property[0].isUpper()) {
+                warning(QStringLiteral("No such property '%1'").arg(property));
+            }
+        }
+        setPropertyValues(values);
+    }
+
+    if (status == UCServiceProperties::Synchronizing) {
+        // set status to active
+        setStatus(UCServiceProperties::Active);
+    }
+
+    // delete watcher
+    call->deleteLater();
+}
+
 /*
  * Slot called when the async read operation finishes.
  */
 void DBusServiceProperties::readFinished(QDBusPendingCallWatcher *call)
 {
-    Q_Q(UCServiceProperties);
     QDBusPendingReply<QVariant> reply = *call;
     QString property = call->property(dynamicProperty).toString();
-    scannedProperties.removeAll(property);
     if (reply.isError()) {
         // remove the property from being watched, as it has no property like that
         properties.removeAll(property);
@@ -193,15 +252,9 @@ void DBusServiceProperties::readFinished(QDBusPendingCallWatcher *call)
             warning(reply.error().message());
         }
     } else {
-        // update watched property value
-        // make sure we have lower case when the property value is updated
-        property[0] = property[0].toLower();
-        q->setProperty(property.toLocal8Bit().constData(), reply.value());
-    }
-
-    if ((status == UCServiceProperties::Synchronizing) && scannedProperties.isEmpty()) {
-        // set status to active
-        setStatus(UCServiceProperties::Active);
+        QVariantMap values;
+        values.insert(property, reply.value());
+        setPropertyValues(values);
     }
 
     // delete watcher
@@ -226,10 +279,15 @@ void DBusServiceProperties::changeServiceOwner(const QString &serviceName, const
  */
 void DBusServiceProperties::updateProperties(const QString &onInterface, const QVariantMap &map, const QStringList &invalidated)
 {
-    Q_UNUSED(onInterface);
-    Q_UNUSED(map);
+    // an empty adaptorInterface watches all the interfaces
+    if (!adaptor.isEmpty() && onInterface != adaptor) {
+        return;
+    }
+    setPropertyValues(map);
     Q_FOREACH(const QString &property, invalidated) {
-        readProperty(property);
+        if (properties.contains(property)) {
+            readProperty(property);
+        }
     }
 }
 
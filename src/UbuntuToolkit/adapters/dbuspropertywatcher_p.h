@@ -19,8 +19,8 @@
 
 #include <QtCore/QObject>
 #include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusMessage>
 #include <QtDBus/QDBusServiceWatcher>
-#include <QtDBus/QDBusInterface>
 
 #include <UbuntuToolkit/private/ucserviceproperties_p_p.h>
 
@@ -41,15 +41,16 @@ public:
     // for testing purposes only!!!
     bool testProperty(const QString &property, const QVariant &value) override;
 
-    QStringList scannedProperties;
     QDBusConnection connection;
     QDBusServiceWatcher *watcher;
-    QDBusInterface *iface;
     QString objectPath;
 
     bool setupInterface();
+    QDBusMessage propertiesCall(const QString &method);
+    void setPropertyValues(const QVariantMap &values);
 
 public Q_SLOTS:
+    void readAllFinished(QDBusPendingCallWatcher *watcher);
     void readFinished(QDBusPendingCallWatcher *watcher);
     void changeServiceOwner(const QString &serviceName, const QString &oldOwner, const QString &newOwner);
     void updateProperties(const QString &iface, const QVariantMap &map, const QStringList &invalidated);
@@ -57,7 +57,15 @@ UT_NAMESPACE_BEGIN
  */
 UbuntuI18n *UbuntuI18n::m_i18 = nullptr;
 
-UbuntuI18n::UbuntuI18n(QObject* parent) : QObject(parent)
+// the translation cache is dropped when it grows over this size
+static const int maxCachedTranslations = 4096;
+
+UbuntuI18n::UbuntuI18n(QObject* parent)
+    : QObject(parent)
+    , m_cacheHits(0)
+    , m_cacheMisses(0)
+    , m_locale12h(-1)
+    , m_dateGeneration(DateProximity::generation())
 {
     /*
      * setlocale
@@ -105,6 +113,8 @@ QString UbuntuI18n::language() const {
  */
 void UbuntuI18n::bindtextdomain(const QString& domain_name, const QString& dir_name) {
     C::bindtextdomain(domain_name.toUtf8(), dir_name.toUtf8());
+    m_translations.clear();
+    m_relativeDateTimes.clear();
     Q_EMIT domainChanged();
 }
 
@@ -113,6 +123,8 @@ void UbuntuI18n::setDomain(const QString &domain) {
         return;
 
     m_domain = domain;
+    m_translations.clear();
+    m_relativeDateTimes.clear();
     C::textdomain(domain.toUtf8());
     /*
      The default is /usr/share/locale if we don't set a folder
@@ -133,6 +145,9 @@ void UbuntuI18n::setLanguage(const QString &lang) {
         return;
 
     m_language = lang;
+    m_translations.clear();
+    m_relativeDateTimes.clear();
+    m_locale12h = -1;
 
     /*
      This is needed for LP: #1263163.
@@ -156,13 +171,39 @@ void UbuntuI18n::setLanguage(const QString &lang) {
     Q_EMIT languageChanged();
 }
 
+bool UbuntuI18n::cachedTranslation(const TranslationKey &key, QString &translation)
+{
+    QHash<TranslationKey, QString>::const_iterator i = m_translations.constFind(key);
+    if (i == m_translations.constEnd()) {
+        m_cacheMisses++;
+        return false;
+    }
+    m_cacheHits++;
+    translation = i.value();
+    return true;
+}
+
+QString UbuntuI18n::cacheTranslation(const TranslationKey &key, const QString &translation)
+{
+    if (m_translations.size() >= maxCachedTranslations) {
+        m_translations.clear();
+    }
+    m_translations.insert(key, translation);
+    return translation;
+}
+
 /*!
  * \qmlmethod string i18n::tr(string text)
  * Translate \a text using gettext and return the translation.
  */
 QString UbuntuI18n::tr(const QString& text)
 {
-    return QString::fromUtf8(C::gettext(text.toUtf8()));
+    TranslationKey key(QString(), QString(), text);
+    QString translation;
+    if (cachedTranslation(key, translation)) {
+        return translation;
+    }
+    return cacheTranslation(key, QString::fromUtf8(C::gettext(text.toUtf8())));
 }
 
 /*!
@@ -175,7 +216,12 @@ QString UbuntuI18n::tr(const QString& text)
  */
 QString UbuntuI18n::tr(const QString &singular, const QString &plural, int n)
 {
-    return QString::fromUtf8(C::ngettext(singular.toUtf8(), plural.toUtf8(), n));
+    TranslationKey key(QString(), QString(), singular, plural, n);
+    QString translation;
+    if (cachedTranslation(key, translation)) {
+        return translation;
+    }
+    return cacheTranslation(key, QString::fromUtf8(C::ngettext(singular.toUtf8(), plural.toUtf8(), n)));
 }
 
 /*!
@@ -184,11 +230,17 @@ QString UbuntuI18n::tr(const QString &singular, const QString &plural, int n)
  */
 QString UbuntuI18n::dtr(const QString& domain, const QString& text)
 {
+    TranslationKey key(domain, QString(), text);
+    QString translation;
+    if (cachedTranslation(key, translation)) {
+        return translation;
+    }
     if (domain.isNull()) {
-        return QString::fromUtf8(C::dgettext(NULL, text.toUtf8()));
+        translation = QString::fromUtf8(C::dgettext(NULL, text.toUtf8()));
     } else {
-        return QString::fromUtf8(C::dgettext(domain.toUtf8(), text.toUtf8()));
+        translation = QString::fromUtf8(C::dgettext(domain.toUtf8(), text.toUtf8()));
     }
+    return cacheTranslation(key, translation);
 }
 
 /*!
@@ -200,11 +252,17 @@ QString UbuntuI18n::dtr(const QString& domain, const QString& text)
  */
 QString UbuntuI18n::dtr(const QString& domain, const QString& singular, const QString& plural, int n)
 {
+    TranslationKey key(domain, QString(), singular, plural, n);
+    QString translation;
+    if (cachedTranslation(key, translation)) {
+        return translation;
+    }
     if (domain.isNull()) {
-        return QString::fromUtf8(C::dngettext(NULL, singular.toUtf8(), plural.toUtf8(), n));
+        translation = QString::fromUtf8(C::dngettext(NULL, singular.toUtf8(), plural.toUtf8(), n));
     } else {
-        return QString::fromUtf8(C::dngettext(domain.toUtf8(), singular.toUtf8(), plural.toUtf8(), n));
+        translation = QString::fromUtf8(C::dngettext(domain.toUtf8(), singular.toUtf8(), plural.toUtf8(), n));
     }
+    return cacheTranslation(key, translation);
 }
 
 /*!
@@ -224,11 +282,17 @@ QString UbuntuI18n::ctr(const QString& context, const QString& text)
  */
 QString UbuntuI18n::dctr(const QString& domain, const QString& context, const QString& text)
 {
+    TranslationKey key(domain, context, text);
+    QString translation;
+    if (cachedTranslation(key, translation)) {
+        return translation;
+    }
     if (domain.isNull()) {
-        return QString::fromUtf8(C::g_dpgettext2(NULL, context.toUtf8(), text.toUtf8()));
+        translation = QString::fromUtf8(C::g_dpgettext2(NULL, context.toUtf8(), text.toUtf8()));
     } else {
-        return QString::fromUtf8(C::g_dpgettext2(domain.toUtf8(), context.toUtf8(), text.toUtf8()));
+        translation = QString::fromUtf8(C::g_dpgettext2(domain.toUtf8(), context.toUtf8(), text.toUtf8()));
     }
+    return cacheTranslation(key, translation);
 }
 
 /*!
@@ -269,32 +333,26 @@ QString UbuntuI18n::tag(const QString& context, const QString& text)
     Q_UNUSED(context);
     return text;
 }
-/*!
- * \qmlmethod string i18n::relativeDateTime(datetime dateTime)
- * Translate a datetime based on proximity to current time.
- */
-QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
-{
-    static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
-
-    QDateTime relativeTo(QDateTime::currentDateTime());
-    const date_proximity_t prox = getDateProximity(relativeTo, datetime);
+static const QString ubuntuUiToolkit = QStringLiteral("ubuntu-ui-toolkit");
 
+// formats a datetime with the given proximity; minutes is the distance in minutes
+// to the current time, used for DATE_PROXIMITY_HOUR
+static QString formatRelativeDateTime(UbuntuI18n *i18n, const QDateTime &datetime,
+                                      date_proximity_t prox, int minutes, bool is12h)
+{
     switch (prox)  {
         case DATE_PROXIMITY_NOW:
             /* TRANSLATORS: Time based "this is happening/happened now" */
-            return dtr(ubuntuUiToolkit, QStringLiteral("Now"));
+            return i18n->dtr(ubuntuUiToolkit, QStringLiteral("Now"));
 
         case DATE_PROXIMITY_HOUR:
         {
-            qint64 diff = datetime.toMSecsSinceEpoch() - relativeTo.toMSecsSinceEpoch();
-            qint64 minutes = qRound(float(diff) / 60000);
             if (minutes < 0) {
-                return dtr(ubuntuUiToolkit, QStringLiteral("%1 minute ago"),
-                           QStringLiteral("%1 minutes ago"), qAbs(minutes)).arg(qAbs(minutes));
+                return i18n->dtr(ubuntuUiToolkit, QStringLiteral("%1 minute ago"),
+                                 QStringLiteral("%1 minutes ago"), qAbs(minutes)).arg(qAbs(minutes));
             }
-            return dtr(ubuntuUiToolkit, QStringLiteral("%1 minute"),
-                       QStringLiteral("%1 minutes"), minutes).arg(minutes);
+            return i18n->dtr(ubuntuUiToolkit, QStringLiteral("%1 minute"),
+                             QStringLiteral("%1 minutes"), minutes).arg(minutes);
         }
 
         case DATE_PROXIMITY_TODAY:
@@ -302,36 +360,36 @@ QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("h:mm ap"))
+            return datetime.toString(is12h
+                ? i18n->dtr(ubuntuUiToolkit, QStringLiteral("h:mm ap"))
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("HH:mm")));
+                : i18n->dtr(ubuntuUiToolkit, QStringLiteral("HH:mm")));
 
         case DATE_PROXIMITY_YESTERDAY:
             /* en_US example: "Yesterday  13:00" */
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'h:mm ap"))
+            return datetime.toString(is12h
+                ? i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'h:mm ap"))
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'HH:mm")));
+                : i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Yesterday\u2003'HH:mm")));
 
         case DATE_PROXIMITY_TOMORROW:
             /* en_US example: "Tomorrow  1:00 PM" */
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'h:mm ap"))
+            return datetime.toString(is12h
+                ? i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'h:mm ap"))
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'HH:mm")));
+                : i18n->dtr(ubuntuUiToolkit, QStringLiteral("'Tomorrow\u2003'HH:mm")));
 
         case DATE_PROXIMITY_LAST_WEEK:
         case DATE_PROXIMITY_NEXT_WEEK:
@@ -339,12 +397,12 @@ QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'h:mm ap"))
+            return datetime.toString(is12h
+                ? i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'h:mm ap"))
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'HH:mm")));
+                : i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd'\u2003'HH:mm")));
 
         case DATE_PROXIMITY_FAR_BACK:
         case DATE_PROXIMITY_FAR_FORWARD:
@@ -352,14 +410,57 @@ QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-            return datetime.toString(isLocale12h()
-                ? dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'h:mm ap"))
+            return datetime.toString(is12h
+                ? i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'h:mm ap"))
             /* TRANSLATORS: Please translate these to your locale datetime
                format using the format specified by
                https://qt-project.org/doc/qt-5-snapshot/qdatetime.html#fromString-2 */
-                : dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'HH:mm")));
+                : i18n->dtr(ubuntuUiToolkit, QStringLiteral("ddd d MMM'\u2003'HH:mm")));
     }
     return datetime.toString(Qt::DefaultLocaleShortDate);
 }
 
+/*!
+ * \qmlmethod string i18n::relativeDateTime(datetime dateTime)
+ * Translate a datetime based on proximity to current time.
+ */
+QString UbuntuI18n::relativeDateTime(const QDateTime& datetime)
+{
+    const DateProximity &proximity = DateProximity::current();
+    qint64 time = datetime.toMSecsSinceEpoch();
+    const date_proximity_t prox = proximity.proximity(time);
+    int minutes = 0;
+    if (prox == DATE_PROXIMITY_HOUR) {
+        minutes = qRound(float(time - proximity.now()) / 60000);
+    }
+    if (m_locale12h < 0) {
+        m_locale12h = isLocale12h() ? 1 : 0;
+    }
+    if (m_dateGeneration != DateProximity::generation()) {
+        // the time zone changed, the cached wall-clock times are stale
+        m_dateGeneration = DateProximity::generation();
+        m_relativeDateTimes.clear();
+    }
+
+    // datetimes with an explicit offset or zone are formatted in their own
+    // clock time, which the key does not cover
+    if (datetime.timeSpec() != Qt::LocalTime && datetime.timeSpec() != Qt::UTC) {
+        return formatRelativeDateTime(this, datetime, prox, minutes, m_locale12h);
+    }
+
+    // the representation only depends on these, so it is reused as long as
+    // the datetime stays in the same proximity
+    QPair<qint64, int> key(time, (datetime.timeSpec() << 20) | ((minutes + 128) << 8) | (prox << 1) | m_locale12h);
+    QHash<QPair<qint64, int>, QString>::const_iterator i = m_relativeDateTimes.constFind(key);
+    if (i != m_relativeDateTimes.constEnd()) {
+        return i.value();
+    }
+    if (m_relativeDateTimes.size() >= maxCachedTranslations) {
+        m_relativeDateTimes.clear();
+    }
+    QString result = formatRelativeDateTime(this, datetime, prox, minutes, m_locale12h);
+    m_relativeDateTimes.insert(key, result);
+    return result;
+}
+
 UT_NAMESPACE_END
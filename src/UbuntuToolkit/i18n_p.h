@@ -19,7 +19,9 @@
 #ifndef I18N_P_H
 #define I18N_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QPair>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
@@ -69,14 +71,63 @@ public:
     void setDomain(const QString& domain);
     void setLanguage(const QString& lang);
 
+    // translation cache statistics
+    quint64 cacheHits() const
+    {
+        return m_cacheHits;
+    }
+    quint64 cacheMisses() const
+    {
+        return m_cacheMisses;
+    }
+    void resetCacheStatistics()
+    {
+        m_cacheHits = m_cacheMisses = 0;
+    }
+
 Q_SIGNALS:
     void domainChanged();
     void languageChanged();
 
 private:
+    // translations are cached for the current language and domain bindings
+    struct TranslationKey {
+        TranslationKey(const QString &domain, const QString &context, const QString &text,
+                       const QString &plural = QString(), int n = 0)
+            : domain(domain), context(context), text(text), plural(plural), n(n)
+            , defaultDomain(domain.isNull())
+        {}
+        bool operator==(const TranslationKey &other) const
+        {
+            return n == other.n && defaultDomain == other.defaultDomain && text == other.text
+                    && context == other.context && plural == other.plural && domain == other.domain;
+        }
+
+        QString domain;
+        QString context;
+        QString text;
+        QString plural;
+        int n;
+        bool defaultDomain;
+    };
+    friend uint qHash(const TranslationKey &key, uint seed)
+    {
+        return qHash(key.text, seed) ^ qHash(key.context, seed) ^ qHash(key.domain, seed) ^ uint(key.n);
+    }
+
+    bool cachedTranslation(const TranslationKey &key, QString &translation);
+    QString cacheTranslation(const TranslationKey &key, const QString &translation);
+
     static UbuntuI18n *m_i18;
     QString m_domain;
     QString m_language;
+    QHash<TranslationKey, QString> m_translations;
+    QHash<QPair<qint64, int>, QString> m_relativeDateTimes;
+    quint64 m_cacheHits;
+    quint64 m_cacheMisses;
+    int m_locale12h;
+    // DateProximity generation the relative datetimes were cached in
+    int m_dateGeneration;
 };
 
 UT_NAMESPACE_END
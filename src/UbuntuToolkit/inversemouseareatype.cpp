@@ -16,7 +16,9 @@
 
 #include "inversemouseareatype_p.h"
 
+#include <QtCore/QHash>
 #include <QtGui/QGuiApplication>
+#include <QtQuick/QQuickView>
 
 #include "quickutils_p.h"
 
@@ -251,13 +253,14 @@ InverseMouseAreaType::InverseMouseAreaType(QQuickItem *parent) :
 
 InverseMouseAreaType::~InverseMouseAreaType()
 {
+    updateEventFilter(false);
 }
 
 void InverseMouseAreaType::updateEventFilter(bool enable)
 {
     m_filteredEvent = false;
     if (!enable && m_filterHost) {
-        m_filterHost->removeEventFilter(this);
+        InverseMouseAreaDispatcher::removeArea(m_filterHost, this);
         m_filterHost.clear();
 
     } else if (enable) {
@@ -267,9 +270,9 @@ void InverseMouseAreaType::updateEventFilter(bool enable)
         }
 
         if (m_filterHost) {
-            m_filterHost->removeEventFilter(this);
+            InverseMouseAreaDispatcher::removeArea(m_filterHost, this);
         }
-        currentWindow->installEventFilter(this);
+        InverseMouseAreaDispatcher::addArea(currentWindow, this);
         m_filterHost = currentWindow;
     }
 }
@@ -319,171 +322,129 @@ void InverseMouseAreaType::componentComplete()
 }
 
 /*
- * Translate mouse, wheel and hover event positions to component's local coordinates.
+ * Handles a window event on behalf of the dispatcher, mapping it to the area
+ * with an event built on the stack. Returns true if the event is consumed.
+ * The rootItem is the item the hover and touch points are relative to.
  */
-QEvent *InverseMouseAreaType::mapEventToArea(QObject *target, QEvent *event, QPoint &point)
+bool InverseMouseAreaType::filterWindowEvent(QQuickItem *rootItem, QEvent *event)
 {
-    QQuickItem *targetItem = qobject_cast<QQuickItem*>(target);
-    // target can be the QQuickView or QQuickWindow, then we need to get the root item from it
-    if (!targetItem) {
-        QQuickView *view = qobject_cast<QQuickView*>(target);
-        if (view) {
-            targetItem = view->rootObject();
-        } else {
-            QQuickWindow *window = qobject_cast<QQuickWindow*>(target);
-            if (window) {
-                targetItem = window->contentItem();
-            }
-        }
-    }
-    Q_ASSERT(target);
+    bool captured = true;
+    QPoint point;
     m_filteredEvent = true;
 
     switch (event->type()) {
     case QEvent::MouseButtonPress:
     case QEvent::MouseButtonRelease:
     case QEvent::MouseButtonDblClick:
-    case QEvent::MouseMove:
-        if (targetItem != this) {
-            // translate coordinates to local
-            QMouseEvent *ev = static_cast<QMouseEvent*>(event);
-            QMouseEvent *mev = new QMouseEvent(ev->type(),
-                                   mapFromScene(ev->windowPos()),
-                                   ev->windowPos(),
-                                   ev->screenPos(),
-                                   ev->button(), ev->buttons(), ev->modifiers());
-            point = mev->pos();
-            return mev;
-        }
-        break;
-    case QEvent::Wheel:
-        if (targetItem != this) {
-            QWheelEvent *ev = static_cast<QWheelEvent*>(event);
-            QWheelEvent *wev = new QWheelEvent(mapFromScene(ev->globalPos()), ev->globalPos(),
-                                               ev->delta(), ev->buttons(), ev->modifiers(), ev->orientation());
-            point = wev->pos();
-            return wev;
-        }
-        break;
+    case QEvent::MouseMove: {
+        // translate coordinates to local
+        QMouseEvent *ev = static_cast<QMouseEvent*>(event);
+        QMouseEvent mev(ev->type(),
+                        mapFromScene(ev->windowPos()),
+                        ev->windowPos(),
+                        ev->screenPos(),
+                        ev->button(), ev->buttons(), ev->modifiers());
+        point = mev.pos();
+        dispatchMouseEvent(&mev);
+        event->setAccepted(mev.isAccepted());
+        } break;
+    case QEvent::Wheel: {
+        QWheelEvent *ev = static_cast<QWheelEvent*>(event);
+        QWheelEvent wev(mapFromScene(ev->globalPos()), ev->globalPos(),
+                        ev->delta(), ev->buttons(), ev->modifiers(), ev->orientation());
+        point = wev.pos();
+        wheelEvent(&wev);
+        event->setAccepted(wev.isAccepted());
+        } break;
     case QEvent::HoverEnter:
     case QEvent::HoverLeave:
     case QEvent::HoverMove: {
-        if (targetItem && targetItem != this) {
-            QHoverEvent *ev = static_cast<QHoverEvent*>(event);
-            QPointF spos = targetItem->mapToScene(ev->posF());
-            QPointF sopos = targetItem->mapToScene(ev->oldPosF());
-            QHoverEvent *hev = new QHoverEvent(ev->type(),
-                                               mapFromScene(spos),
-                                               mapFromScene(sopos),
-                                               ev->modifiers());
-            point = hev->pos();
-            return hev;
+        // hover is only delivered to the areas accepting it
+        if (!rootItem || !acceptHoverEvents()) {
+            captured = false;
+            break;
+        }
+        QHoverEvent *ev = static_cast<QHoverEvent*>(event);
+        QPointF spos = rootItem->mapToScene(ev->posF());
+        QPointF sopos = rootItem->mapToScene(ev->oldPosF());
+        QHoverEvent hev(ev->type(), mapFromScene(spos), mapFromScene(sopos), ev->modifiers());
+        point = hev.pos();
+        if (ev->type() == QEvent::HoverEnter) {
+            hoverEnterEvent(&hev);
+        } else if (ev->type() == QEvent::HoverLeave) {
+            hoverLeaveEvent(&hev);
+        } else {
+            hoverMoveEvent(&hev);
         }
+        event->setAccepted(hev.isAccepted());
         } break;
     // convert touch events into mouse events and continue handling as such
-    case QEvent::TouchBegin: {
-        QTouchEvent *tev = static_cast<QTouchEvent*>(event);
-        QList<QTouchEvent::TouchPoint> points = tev->touchPoints();
-        const QTouchEvent::TouchPoint &primaryPoint = points.first();
-        m_touchId = primaryPoint.id();
-        QPointF pos = targetItem->mapToScene(primaryPoint.pos());
-        QMouseEvent *mev = new QMouseEvent(QEvent::MouseButtonPress,
-                        mapFromScene(pos),
-                        primaryPoint.scenePos(),
-                        primaryPoint.screenPos(),
-                        Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
-        point = mev->pos();
-        return mev;
-        } break;
-    case QEvent::TouchUpdate: {
-        QTouchEvent *tev = static_cast<QTouchEvent*>(event);
-        QList<QTouchEvent::TouchPoint> points = tev->touchPoints();
-        const QTouchEvent::TouchPoint &primaryPoint = points.first();
-        QPointF pos = targetItem->mapToScene(primaryPoint.pos());
-        QMouseEvent *mev = new QMouseEvent(QEvent::MouseMove,
-                        mapFromScene(pos),
-                        primaryPoint.scenePos(),
-                        primaryPoint.screenPos(),
-                        Qt::NoButton, Qt::NoButton, Qt::NoModifier);
-        point = mev->pos();
-        return mev;
-        } break;
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
     case QEvent::TouchEnd: {
-        QMouseEvent *mev = 0;
-        QTouchEvent *tev = static_cast<QTouchEvent*>(event);
-        QList<QTouchEvent::TouchPoint> points = tev->touchPoints();
-        for (int i = 0; i < points.count(); i++) {
-            const QTouchEvent::TouchPoint &point = points.at(i);
-            if (point.id() != m_touchId) {
-                continue;
+        const QList<QTouchEvent::TouchPoint> &points = static_cast<QTouchEvent*>(event)->touchPoints();
+        const QTouchEvent::TouchPoint *primaryPoint = 0;
+        if (event->type() == QEvent::TouchBegin) {
+            primaryPoint = &points.first();
+            m_touchId = primaryPoint->id();
+        } else if (event->type() == QEvent::TouchUpdate) {
+            primaryPoint = &points.first();
+        } else {
+            for (int i = 0; i < points.count(); i++) {
+                if (points.at(i).id() == m_touchId) {
+                    primaryPoint = &points.at(i);
+                    break;
+                }
             }
-            QPointF pos = targetItem->mapToScene(point.pos());
-            mev = new QMouseEvent(QEvent::MouseButtonRelease,
-                            mapFromScene(pos),
-                            point.scenePos(),
-                            point.screenPos(),
-                            Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+        }
+        if (!rootItem || !primaryPoint) {
+            captured = false;
             break;
         }
-        point = mev->pos();
-        return mev;
+        static const QEvent::Type mouseType[] = {
+            QEvent::MouseButtonPress, QEvent::MouseMove, QEvent::MouseButtonRelease
+        };
+        const int index = (event->type() == QEvent::TouchBegin) ? 0
+                        : (event->type() == QEvent::TouchUpdate) ? 1 : 2;
+        const Qt::MouseButton button = (index == 1) ? Qt::NoButton : Qt::LeftButton;
+        QPointF pos = rootItem->mapToScene(primaryPoint->pos());
+        QMouseEvent mev(mouseType[index],
+                        mapFromScene(pos),
+                        primaryPoint->scenePos(),
+                        primaryPoint->screenPos(),
+                        button, button, Qt::NoModifier);
+        point = mev.pos();
+        dispatchMouseEvent(&mev);
+        event->setAccepted(mev.isAccepted());
         } break;
     default:
-        m_filteredEvent = false;
-        point = QPoint();
+        captured = false;
         break;
     }
-    return event;
+
+    m_filteredEvent = false;
+    // consume the event
+    return captured && event->isAccepted() && contains(point);
 }
 
-bool InverseMouseAreaType::eventFilter(QObject *object, QEvent *event)
+void InverseMouseAreaType::dispatchMouseEvent(QMouseEvent *event)
 {
-    if (object != this)
-    {
-        bool captured = true;
-        QPoint point;
-        QEvent *mappedEvent = mapEventToArea(object, event, point);
-
-        switch (mappedEvent->type()) {
-        case QEvent::MouseButtonPress:
-            mousePressEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::MouseButtonRelease:
-            mouseReleaseEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::MouseButtonDblClick:
-            mouseDoubleClickEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::MouseMove:
-            mouseMoveEvent(static_cast<QMouseEvent*>(mappedEvent));
-            break;
-        case QEvent::Wheel:
-            wheelEvent(static_cast<QWheelEvent*>(mappedEvent));
-            break;
-        case QEvent::HoverEnter:
-            hoverEnterEvent(static_cast<QHoverEvent*>(mappedEvent));
-            break;
-        case QEvent::HoverLeave:
-            hoverLeaveEvent(static_cast<QHoverEvent*>(mappedEvent));
-            break;
-        case QEvent::HoverMove:
-            hoverMoveEvent(static_cast<QHoverEvent*>(mappedEvent));
-            break;
-        default:
-            captured = false;
-            break;
-        }
-        if (mappedEvent != event) {
-            event->setAccepted(mappedEvent->isAccepted());
-            delete mappedEvent;
-        }
-        m_filteredEvent = false;
-        if (captured && event->isAccepted() && contains(point)) {
-            // consume the event
-            return true;
-        }
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+        mousePressEvent(event);
+        break;
+    case QEvent::MouseButtonRelease:
+        mouseReleaseEvent(event);
+        break;
+    case QEvent::MouseButtonDblClick:
+        mouseDoubleClickEvent(event);
+        break;
+    case QEvent::MouseMove:
+        mouseMoveEvent(event);
+        break;
+    default:
+        break;
     }
-    return false;
 }
 
 void InverseMouseAreaType::mousePressEvent(QMouseEvent *event)
@@ -572,4 +533,95 @@ bool InverseMouseAreaType::contains(const QPointF &point) const
     return !pointInArea && !pointInOSK && pointOutArea;
 }
 
+/******************************************************************************
+ * InverseMouseAreaDispatcher
+ */
+static QHash<QQuickWindow*, InverseMouseAreaDispatcher*> dispatchers;
+
+InverseMouseAreaDispatcher::InverseMouseAreaDispatcher(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+{
+    dispatchers.insert(m_window, this);
+    m_window->installEventFilter(this);
+}
+
+InverseMouseAreaDispatcher::~InverseMouseAreaDispatcher()
+{
+    dispatchers.remove(m_window);
+}
+
+void InverseMouseAreaDispatcher::addArea(QQuickWindow *window, InverseMouseAreaType *area)
+{
+    InverseMouseAreaDispatcher *dispatcher = dispatchers.value(window);
+    if (!dispatcher) {
+        dispatcher = new InverseMouseAreaDispatcher(window);
+    }
+    dispatcher->m_areas.removeAll(area);
+    dispatcher->m_areas.append(area);
+}
+
+void InverseMouseAreaDispatcher::removeArea(QQuickWindow *window, InverseMouseAreaType *area)
+{
+    InverseMouseAreaDispatcher *dispatcher = dispatchers.value(window);
+    if (dispatcher) {
+        dispatcher->m_areas.removeAll(area);
+    }
+}
+
+bool InverseMouseAreaDispatcher::eventFilter(QObject *object, QEvent *event)
+{
+    if (object != m_window || m_areas.isEmpty()) {
+        return false;
+    }
+
+    bool hover = false;
+    switch (event->type()) {
+    case QEvent::HoverEnter:
+    case QEvent::HoverLeave:
+    case QEvent::HoverMove:
+        hover = true;
+        // fall through
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+        break;
+    default:
+        return false;
+    }
+
+    if (hover) {
+        bool hoverEnabled = false;
+        for (int i = 0; i < m_areas.size() && !hoverEnabled; i++) {
+            hoverEnabled = m_areas[i]->acceptHoverEvents();
+        }
+        if (!hoverEnabled) {
+            return false;
+        }
+    }
+
+    // hover and touch points are relative to the root item of the window
+    QQuickView *view = qobject_cast<QQuickView*>(m_window);
+    QQuickItem *rootItem = (view && view->rootObject()) ? view->rootObject() : m_window->contentItem();
+
+    // areas may get removed while handling the event, the copy is not
+    // detached unless that happens
+    const QVector<InverseMouseAreaType*> areas = m_areas;
+    for (int i = areas.size() - 1; i >= 0; i--) {
+        InverseMouseAreaType *area = areas[i];
+        if (areas.constData() != m_areas.constData() && !m_areas.contains(area)) {
+            continue;
+        }
+        if (area->filterWindowEvent(rootItem, event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 UT_NAMESPACE_END
@@ -18,6 +18,7 @@
 #define INVERSEMOUSEAREATYPE_P_H
 
 #include <QtCore/QPointer>
+#include <QtCore/QVector>
 #include <QtQuick/private/qquickmousearea_p.h>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
@@ -40,7 +41,6 @@ public:
 protected:
     void itemChange(ItemChange, const ItemChangeData &) override;
     void componentComplete() override;
-    bool eventFilter(QObject *, QEvent *) override;
 
     // override mouse events
     void mousePressEvent(QMouseEvent *event) override;
@@ -52,7 +52,8 @@ private: // getter/setter
     void setSensingArea(QQuickItem *sensing);
     bool topmostItem() const;
     void setTopmostItem(bool value);
-    QEvent * mapEventToArea(QObject *target, QEvent *event, QPoint &point);
+    bool filterWindowEvent(QQuickItem *rootItem, QEvent *event);
+    void dispatchMouseEvent(QMouseEvent *event);
 
 Q_SIGNALS:
     void sensingAreaChanged();
@@ -66,11 +67,33 @@ private:
     bool m_ready:1;
     bool m_topmostItem:1;
     bool m_filteredEvent:1;
-    QPointer<QObject> m_filterHost;
+    QPointer<QQuickWindow> m_filterHost;
     QPointer<QQuickItem> m_sensingArea;
     int m_touchId;
 
     void updateEventFilter(bool enable);
+
+    friend class InverseMouseAreaDispatcher;
+};
+
+// Filters the events of a window once for all the InverseMouseAreas placed
+// above their sensing area (topmostItem set).
+class InverseMouseAreaDispatcher : public QObject
+{
+public:
+    static void addArea(QQuickWindow *window, InverseMouseAreaType *area);
+    static void removeArea(QQuickWindow *window, InverseMouseAreaType *area);
+
+protected:
+    bool eventFilter(QObject *object, QEvent *event) override;
+
+private:
+    explicit InverseMouseAreaDispatcher(QQuickWindow *window);
+    ~InverseMouseAreaDispatcher();
+
+    QQuickWindow *m_window;
+    // in registration order, the last registered area filters first
+    QVector<InverseMouseAreaType*> m_areas;
 };
 
 UT_NAMESPACE_END
@@ -40,12 +40,14 @@ public:
 
     // methods
     void updatePixelSize();
+    static const QFont &defaultFont(UCLabel::TextSize size);
 
     // members
     enum {
         TextSizeSet = 1,
         PixelSizeSet = 2,
-        ColorSet = 4
+        ColorSet = 4,
+        FontSet = 8
     };
 
     UCLabel *q_ptr;
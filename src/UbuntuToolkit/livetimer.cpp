@@ -15,6 +15,7 @@
  */
 
 #include "livetimer_p_p.h"
+#include "timeutils_p.h"
 
 UT_NAMESPACE_BEGIN
 
@@ -52,7 +53,8 @@ LiveTimer::LiveTimer(QObject *parent)
     : QObject(parent)
     , m_frequency(Disabled)
     , m_effectiveFrequency(Disabled)
-    , m_lastUpdate(0)
+    , m_relativeMSecs(0)
+    , m_proximity(-1)
 {
 }
 
@@ -76,10 +78,10 @@ LiveTimer::~LiveTimer()
     \li \b LiveTimer.Second - emit the \l trigger signal on every change of second.
     \li \b LiveTimer.Minute - emit the \l trigger signal on every change of minute.
     \li \b LiveTimer.Hour - emit the \l trigger signal on every change of hour.
-    \li \b LiveTimer.Relative - emit the \l trigger signal periodically depending on how close current time is to to
-    \l relativeTime. If \l relativeTime is within 30 seconds of the current time, trigger every 30 seconds. Within an hour,
-    trigger every minute. Otherwise, trigger every hour until the relative time is more than a week past current time, after which
-    updates are disabled.
+    \li \b LiveTimer.Relative - emit the \l trigger signal when the representation of \l relativeTime relative to the
+    current time changes, as given by i18n.relativeDateTime(). Within an hour of the current time the signal is emitted
+    every minute, otherwise when the relative time moves to a different proximity (today, yesterday, last week, etc).
+    Updates are disabled once the relative time is more than a week past current time.
 
     \note Setting the frequency to LiveTimer.Relative will disable the timer until a \l relativeTime is set.
 
@@ -110,6 +112,8 @@ void LiveTimer::setRelativeTime(const QDateTime &relativeTime)
 {
     if (m_relativeTime != relativeTime) {
         m_relativeTime = relativeTime;
+        m_relativeMSecs = relativeTime.isValid() ? relativeTime.toMSecsSinceEpoch() : 0;
+        m_proximity = -1;
         Q_EMIT relativeTimeChanged();
 
         if (m_frequency == Relative) {
@@ -136,6 +140,26 @@ void LiveTimer::unregisterTimer()
 
 }
 
+bool LiveTimer::updateRelativeProximity(const DateProximity &proximity, bool isMinuteUpdate)
+{
+    date_proximity_t newProximity = proximity.proximity(m_relativeMSecs);
+    if (m_proximity < 0) {
+        // not evaluated yet, nothing to compare with
+        m_proximity = newProximity;
+        return false;
+    }
+    // only trigger when the relative representation changes, that is either
+    // the proximity changes or the minutes within the hour proximity
+    if (newProximity != m_proximity) {
+        m_proximity = newProximity;
+        Q_EMIT trigger();
+        return true;
+    } else if (newProximity == DATE_PROXIMITY_HOUR && isMinuteUpdate) {
+        Q_EMIT trigger();
+    }
+    return false;
+}
+
 void LiveTimer::setEffectiveFrequency(LiveTimer::Frequency frequency)
 {
     m_effectiveFrequency = frequency;
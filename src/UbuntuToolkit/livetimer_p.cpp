@@ -60,11 +60,12 @@ void SharedLiveTimer::updateFrequency()
     if (m_liveTimers.count() == 0) {
         newFreq = LiveTimer::Disabled;
     } else {
+        const DateProximity &proximity = DateProximity::current();
         Q_FOREACH(LiveTimer* timer, m_liveTimers) {
             LiveTimer::Frequency freq = timer->frequency();
             if (freq == LiveTimer::Relative) {
-                date_proximity_t proximity = getDateProximity(QDateTime::currentDateTime(), timer->relativeTime());
-                freq = frequencyForProximity(proximity);
+                timer->m_proximity = proximity.proximity(timer->m_relativeMSecs);
+                freq = frequencyForProximity(static_cast<date_proximity_t>(timer->m_proximity));
             }
             timer->setEffectiveFrequency(freq);
 
@@ -127,12 +128,21 @@ void SharedLiveTimer::timeout()
             m_lastUpdate.time().second() != now.time().second();
 
     bool needsFrequencyUpdate = false;
+    const DateProximity &proximity = DateProximity::current();
     QList<LiveTimer*> tmpTimers(m_liveTimers);
     Q_FOREACH(LiveTimer* timer, tmpTimers) {
 
         LiveTimer::Frequency effectiveFrequency = timer->effectiveFrequency();
         if (effectiveFrequency == LiveTimer::Disabled) continue;
 
+        if (timer->frequency() == LiveTimer::Relative) {
+            if (timer->updateRelativeProximity(proximity, isMinuteUpdate)) {
+                date_proximity_t newProximity = static_cast<date_proximity_t>(timer->m_proximity);
+                needsFrequencyUpdate |= effectiveFrequency != frequencyForProximity(newProximity);
+            }
+            continue;
+        }
+
         if (isHourUpdate) {
             Q_EMIT timer->trigger();
         } else if (isMinuteUpdate) {
@@ -144,12 +154,6 @@ void SharedLiveTimer::timeout()
                 Q_EMIT timer->trigger();
             }
         }
-
-        // re-evaluate relative timer frequency
-        if (timer->frequency() == LiveTimer::Relative) {
-            date_proximity_t newProximity = getDateProximity(now, timer->relativeTime());
-            needsFrequencyUpdate |= effectiveFrequency != frequencyForProximity(newProximity);
-        }
     }
 
     if (needsFrequencyUpdate) {
@@ -164,6 +168,9 @@ void SharedLiveTimer::timedate1PropertiesChanged(const QString &interface, const
     if (interface != dbusService) return;
     if (!changed.contains(QStringLiteral("Timezone"))) return;
 
+    // day boundaries move with the time zone
+    DateProximity::invalidate();
+
     QList<LiveTimer*> tmpTimers(m_liveTimers);
     Q_FOREACH(LiveTimer* timer, tmpTimers) {
         Q_EMIT timer->trigger();
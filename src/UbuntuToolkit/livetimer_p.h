@@ -24,6 +24,8 @@
 
 UT_NAMESPACE_BEGIN
 
+class DateProximity;
+
 class UBUNTUTOOLKIT_EXPORT LiveTimer : public QObject
 {
     Q_OBJECT
@@ -50,6 +52,10 @@ public:
 
     Frequency effectiveFrequency() const { return m_effectiveFrequency; }
 
+    // triggers when the representation of the relative time changes at the
+    // given proximity, returns true when the proximity itself changed
+    bool updateRelativeProximity(const DateProximity &proximity, bool isMinuteUpdate);
+
 Q_SIGNALS:
     void frequencyChanged();
     void relativeTimeChanged();
@@ -64,7 +70,9 @@ private:
     Frequency m_frequency;
     Frequency m_effectiveFrequency;
     QDateTime m_relativeTime;
-    quint64 m_lastUpdate;
+    qint64 m_relativeMSecs;
+    // last proximity of the relative time, as date_proximity_t
+    int m_proximity;
 
     friend class SharedLiveTimer;
 };
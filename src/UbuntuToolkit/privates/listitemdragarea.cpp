@@ -19,7 +19,7 @@
 #include <QtCore/QtMath>
 #include <QtQml/QQmlInfo>
 #include <QtQuick/private/qquickitem_p.h>
-#include <QtQuick/private/qquickflickable_p.h>
+#include <QtQuick/private/qquickitemview_p.h>
 
 #include "privates/listitemdraghandler_p.h"
 #include "uclistitem_p_p.h"
@@ -37,7 +37,7 @@ UT_NAMESPACE_BEGIN
 
 ListItemDragArea::ListItemDragArea(QQuickItem *parent)
     : QQuickItem(parent)
-    , listView(static_cast<QQuickFlickable*>(parent))
+    , listView(static_cast<QQuickItemView*>(parent))
     , viewAttached(0)
     , scrollDirection(0)
     , fromIndex(-1)
@@ -149,6 +149,7 @@ void ListItemDragArea::mouseReleaseEvent(QMouseEvent *event)
     UCViewItemsAttachedPrivate *pViewAttached = UCViewItemsAttachedPrivate::get(viewAttached);
     if (pViewAttached->isDragUpdatedConnected()) {
         UCDragEvent drag(UCDragEvent::Dropped, fromIndex, toIndex, min, max);
+        pViewAttached->modelMovedRows = false;
         Q_EMIT viewAttached->dragUpdated(&drag);
         updateDraggedItem();
         if (drag.m_accept) {
@@ -225,6 +226,7 @@ void ListItemDragArea::mouseMoveEvent(QMouseEvent *event)
         UCViewItemsAttachedPrivate *pViewAttached = UCViewItemsAttachedPrivate::get(viewAttached);
         if (pViewAttached->isDragUpdatedConnected()) {
             UCDragEvent drag(UCDragEvent::Moving, fromIndex, toIndex, min, max);
+            pViewAttached->modelMovedRows = false;
             Q_EMIT viewAttached->dragUpdated(&drag);
             update = drag.m_accept;
             if (update) {
@@ -247,34 +249,17 @@ QPointF ListItemDragArea::mapDragAreaPos()
     return pos;
 }
 
-// calls ListView.indexAt() invokable
+// returns the model index of the delegate at the given ListView content position;
+// called on every mouse move, so query the view directly, not via invokable
 int ListItemDragArea::indexAt(qreal x, qreal y)
 {
-    if (!listView) {
-        return -1;
-    }
-    int result = -1;
-    QMetaObject::invokeMethod(listView, "indexAt", Qt::DirectConnection,
-                              Q_RETURN_ARG(int, result),
-                              Q_ARG(qreal, x),
-                              Q_ARG(qreal, y)
-                              );
-    return result;
+    return listView ? listView->indexAt(x, y) : -1;
 }
 
-// calls ListView.itemAt() invokable
+// returns the delegate at the given ListView content position
 UCListItem *ListItemDragArea::itemAt(qreal x, qreal y)
 {
-    if (!listView) {
-        return NULL;
-    }
-    QQuickItem *result = 0;
-    QMetaObject::invokeMethod(listView, "itemAt", Qt::DirectConnection,
-                              Q_RETURN_ARG(QQuickItem*, result),
-                              Q_ARG(qreal, x),
-                              Q_ARG(qreal, y)
-                              );
-    return static_cast<UCListItem*>(result);
+    return listView ? qobject_cast<UCListItem*>(listView->itemAt(x, y)) : nullptr;
 }
 
 // creates a temporary list item available for the dragging time
@@ -283,7 +268,7 @@ void ListItemDragArea::createDraggedItem(UCListItem *baseItem)
     if (item || !baseItem) {
         return;
     }
-    QQmlComponent *delegate = listView->property("delegate").value<QQmlComponent*>();
+    QQmlComponent *delegate = listView->delegate();
     if (!delegate) {
         return;
     }
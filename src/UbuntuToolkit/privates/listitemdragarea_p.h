@@ -23,7 +23,7 @@
 #include <UbuntuToolkit/private/uclistitem_p.h>
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
-class QQuickFlickable;
+class QQuickItemView;
 
 UT_NAMESPACE_BEGIN
 
@@ -44,7 +44,7 @@ protected:
 private:
     QBasicTimer scrollTimer;
     QPointer<UCListItem> item;
-    QQuickFlickable *listView;
+    QQuickItemView *listView;
     UCViewItemsAttached *viewAttached;
     QPointF lastPos, mousePos;
     int scrollDirection;
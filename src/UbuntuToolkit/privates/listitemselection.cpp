@@ -18,8 +18,178 @@
 
 #include "uclistitem_p_p.h"
 
+#include <algorithm>
+
 UT_NAMESPACE_BEGIN
 
+ListItemSelectionRanges ListItemSelectionRanges::fromList(const QList<int> &indices)
+{
+    QList<int> sorted(indices);
+    std::sort(sorted.begin(), sorted.end());
+    ListItemSelectionRanges ranges;
+    Q_FOREACH(int index, sorted) {
+        // indices are sorted, so only the last range can grow
+        if (!ranges.m_ranges.isEmpty() && ranges.m_ranges.last().last + 1 >= index) {
+            if (ranges.m_ranges.last().last < index) {
+                ranges.m_ranges.last().last = index;
+                ranges.m_count++;
+            }
+        } else {
+            Range range = {index, index};
+            ranges.m_ranges.append(range);
+            ranges.m_count++;
+        }
+    }
+    return ranges;
+}
+
+QList<int> ListItemSelectionRanges::toList() const
+{
+    QList<int> indices;
+    indices.reserve(m_count);
+    Q_FOREACH(const Range &range, m_ranges) {
+        for (int i = range.first; i <= range.last; i++) {
+            indices.append(i);
+        }
+    }
+    return indices;
+}
+
+// returns the position of the first range ending at or after index
+int ListItemSelectionRanges::lowerBound(int index) const
+{
+    return std::lower_bound(m_ranges.constBegin(), m_ranges.constEnd(), index,
+                            [](const Range &range, int value) { return range.last < value; })
+            - m_ranges.constBegin();
+}
+
+bool ListItemSelectionRanges::contains(int index) const
+{
+    int i = lowerBound(index);
+    return i < m_ranges.size() && m_ranges[i].first <= index;
+}
+
+int ListItemSelectionRanges::insert(int first, int last)
+{
+    if (first > last) {
+        return 0;
+    }
+    // ranges overlapping or adjacent to [first, last] get merged
+    int from = lowerBound(first - 1);
+    int to = from;
+    Range merged = {first, last};
+    int mergedCount = 0;
+    while (to < m_ranges.size() && m_ranges[to].first <= qint64(last) + 1) {
+        merged.first = qMin(merged.first, m_ranges[to].first);
+        merged.last = qMax(merged.last, m_ranges[to].last);
+        mergedCount += m_ranges[to].last - m_ranges[to].first + 1;
+        to++;
+    }
+    int added = merged.last - merged.first + 1 - mergedCount;
+    if (to - from == 1) {
+        m_ranges[from] = merged;
+    } else {
+        m_ranges.remove(from, to - from);
+        m_ranges.insert(from, merged);
+    }
+    m_count += added;
+    return added;
+}
+
+int ListItemSelectionRanges::remove(int first, int last)
+{
+    if (first > last) {
+        return 0;
+    }
+    int from = lowerBound(first);
+    int to = from;
+    int removed = 0;
+    QVector<Range> remainders;
+    while (to < m_ranges.size() && m_ranges[to].first <= last) {
+        const Range &range = m_ranges[to];
+        if (range.first < first) {
+            Range left = {range.first, first - 1};
+            remainders.append(left);
+        }
+        if (range.last > last) {
+            Range right = {last + 1, range.last};
+            remainders.append(right);
+        }
+        removed += qMin(range.last, last) - qMax(range.first, first) + 1;
+        to++;
+    }
+    if (removed) {
+        m_ranges.remove(from, to - from);
+        for (int i = 0; i < remainders.size(); i++) {
+            m_ranges.insert(from + i, remainders[i]);
+        }
+        m_count -= removed;
+    }
+    return removed;
+}
+
+void ListItemSelectionRanges::clear()
+{
+    m_ranges.clear();
+    m_count = 0;
+}
+
+void ListItemSelectionRanges::shiftInserted(int index, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    int i = lowerBound(index);
+    if (i < m_ranges.size() && m_ranges[i].first < index) {
+        // the inserted rows split the range, and are not selected
+        Range right = {index + count, m_ranges[i].last + count};
+        m_ranges[i].last = index - 1;
+        m_ranges.insert(++i, right);
+        i++;
+    }
+    for (; i < m_ranges.size(); i++) {
+        m_ranges[i].first += count;
+        m_ranges[i].last += count;
+    }
+}
+
+void ListItemSelectionRanges::shiftRemoved(int index, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+    remove(index, index + count - 1);
+    int i = lowerBound(index);
+    for (int j = i; j < m_ranges.size(); j++) {
+        m_ranges[j].first -= count;
+        m_ranges[j].last -= count;
+    }
+    // the ranges around the removed rows may have become adjacent
+    if (i > 0 && i < m_ranges.size() && m_ranges[i - 1].last + 1 == m_ranges[i].first) {
+        m_ranges[i - 1].last = m_ranges[i].last;
+        m_ranges.remove(i);
+    }
+}
+
+void ListItemSelectionRanges::move(int from, int to, int count)
+{
+    if (from == to || count <= 0) {
+        return;
+    }
+    // collect the selection of the moved rows relative to their first row
+    QVector<Range> moved;
+    const int last = from + count - 1;
+    for (int i = lowerBound(from); i < m_ranges.size() && m_ranges[i].first <= last; i++) {
+        Range range = {qMax(m_ranges[i].first, from) - from, qMin(m_ranges[i].last, last) - from};
+        moved.append(range);
+    }
+    shiftRemoved(from, count);
+    shiftInserted(to, count);
+    Q_FOREACH(const Range &range, moved) {
+        insert(range.first + to, range.last + to);
+    }
+}
+
 ListItemSelection::ListItemSelection(UCListItem *parent)
     : QObject(parent)
     , hostItem(parent)
@@ -113,12 +283,14 @@ void ListItemSelection::setSelected(bool selected)
         return;
     }
     if (viewItems) {
-        // this->selected is updated through updateSelected()
+        // ViewItems notifies the selection change of the other items later
         if (selected) {
             UCViewItemsAttachedPrivate::get(viewItems.data())->addSelectedItem(hostItem);
         } else {
             UCViewItemsAttachedPrivate::get(viewItems.data())->removeSelectedItem(hostItem);
         }
+        this->selected = selected;
+        Q_EMIT hostItem->selectedChanged();
     } else {
         this->selected = selected;
         dirtyFlags |= SelectedDirty;
@@ -134,11 +306,10 @@ void ListItemSelection::onSelectModeChanged()
     Q_EMIT hostItem->selectModeChanged();
 }
 
-void ListItemSelection::onSelectedIndicesChanged(const QList<int> &indices)
+void ListItemSelection::onSelectedIndicesChanged()
 {
-    UCListItemPrivate *d = UCListItemPrivate::get(hostItem);
-    if (selected != indices.contains(d->index())) {
-        selected = indices.contains(d->index());
+    if (selected != isSelected()) {
+        selected = !selected;
         Q_EMIT hostItem->selectedChanged();
     }
 }
@@ -19,11 +19,63 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
+#include <QtCore/QVector>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
 UT_NAMESPACE_BEGIN
 
+// Set of selected indices stored as sorted, disjoint and non-adjacent ranges.
+// Lookups are logarithmic, and selecting or shifting blocks of indices costs as
+// much as the number of ranges touched, not the number of indices.
+class ListItemSelectionRanges
+{
+public:
+    struct Range {
+        int first;
+        int last;
+        bool operator==(const Range &other) const
+        {
+            return first == other.first && last == other.last;
+        }
+    };
+
+    ListItemSelectionRanges() : m_count(0) {}
+    static ListItemSelectionRanges fromList(const QList<int> &indices);
+    QList<int> toList() const;
+
+    bool operator==(const ListItemSelectionRanges &other) const
+    {
+        return m_ranges == other.m_ranges;
+    }
+    bool operator!=(const ListItemSelectionRanges &other) const
+    {
+        return !(*this == other);
+    }
+
+    int count() const
+    {
+        return m_count;
+    }
+    bool contains(int index) const;
+    // insert/remove return the number of indices added/removed
+    int insert(int first, int last);
+    int remove(int first, int last);
+    void clear();
+
+    // follow model changes: rows inserted at index, rows removed from index
+    // and rows moved from one index to another
+    void shiftInserted(int index, int count);
+    void shiftRemoved(int index, int count);
+    void move(int from, int to, int count);
+
+private:
+    int lowerBound(int index) const;
+
+    QVector<Range> m_ranges;
+    int m_count;
+};
+
 class UCViewItemsAttached;
 class UCListItem;
 class ListItemSelection : public QObject
@@ -41,7 +93,7 @@ public:
     void setSelected(bool selected);
 
     void onSelectModeChanged();
-    void onSelectedIndicesChanged(const QList<int> &indices);
+    void onSelectedIndicesChanged();
 
 private:
     QPointer<UCViewItemsAttached> viewItems;
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timeutils_p.h"
+
+UT_NAMESPACE_BEGIN
+
+static inline qint64 startOfDay(const QDate &date)
+{
+    return QDateTime(date, QTime(0, 0, 0, 0)).toMSecsSinceEpoch();
+}
+
+DateProximity::DateProximity()
+    : m_now(0)
+    , m_updated(0)
+    , m_lastWeek(0)
+    , m_yesterday(0)
+    , m_today(0)
+    , m_tomorrow(0)
+    , m_dayAfterTomorrow(0)
+    , m_nextWeek(0)
+{
+}
+
+DateProximity::DateProximity(const QDateTime &now)
+    : m_now(now.toMSecsSinceEpoch())
+    , m_updated(m_now)
+{
+    QDate today(now.date());
+    m_lastWeek = startOfDay(today.addDays(-6));
+    m_yesterday = startOfDay(today.addDays(-1));
+    m_today = startOfDay(today);
+    m_tomorrow = startOfDay(today.addDays(1));
+    m_dayAfterTomorrow = startOfDay(today.addDays(2));
+    m_nextWeek = startOfDay(today.addDays(7));
+}
+
+static int proximityGeneration = 0;
+
+static DateProximity &sharedProximity()
+{
+    static DateProximity proximity;
+    return proximity;
+}
+
+const DateProximity &DateProximity::current()
+{
+    DateProximity &proximity = sharedProximity();
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now < proximity.m_today || now >= proximity.m_tomorrow || (now - proximity.m_updated) >= 3600000) {
+        proximity = DateProximity(QDateTime::fromMSecsSinceEpoch(now));
+    } else {
+        proximity.m_now = now;
+    }
+    return proximity;
+}
+
+// to be called when the time zone changes
+void DateProximity::invalidate()
+{
+    sharedProximity() = DateProximity();
+    proximityGeneration++;
+}
+
+int DateProximity::generation()
+{
+    return proximityGeneration;
+}
+
+date_proximity_t DateProximity::proximity(qint64 time) const
+{
+    qint64 diff = qAbs(time - m_now);
+    if (diff < 30000) {
+        return DATE_PROXIMITY_NOW;
+    } else if (diff < 3600000) {
+        return DATE_PROXIMITY_HOUR;
+    }
+
+    if (time >= m_today && time < m_tomorrow) {
+        return DATE_PROXIMITY_TODAY;
+    }
+    if (time >= m_yesterday && time < m_today) {
+        return DATE_PROXIMITY_YESTERDAY;
+    }
+    if (time >= m_tomorrow && time < m_dayAfterTomorrow) {
+        return DATE_PROXIMITY_TOMORROW;
+    }
+
+    if (time < m_now) {
+        return (time >= m_lastWeek) ? DATE_PROXIMITY_LAST_WEEK : DATE_PROXIMITY_FAR_BACK;
+    }
+    return (time < m_nextWeek) ? DATE_PROXIMITY_NEXT_WEEK : DATE_PROXIMITY_FAR_FORWARD;
+}
+
+UT_NAMESPACE_END
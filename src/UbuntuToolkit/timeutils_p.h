@@ -62,62 +62,42 @@ typedef enum
    DATE_PROXIMITY_FAR_FORWARD
 } date_proximity_t;
 
-inline date_proximity_t getDateProximity(const QDateTime& now, const QDateTime& time)
+/* Day boundaries around a given current time, so the proximity of any number
+   of timestamps can be evaluated with plain integer comparisons. */
+class UBUNTUTOOLKIT_EXPORT DateProximity
 {
-   int now_day = now.date().day();
-   int now_month = now.date().month();
-   int now_year = now.date().year();
-
-   int time_day = time.date().day();
-   int time_month = time.date().month();
-   int time_year = time.date().year();
-
-   qint64 diff = time.toMSecsSinceEpoch() - now.toMSecsSinceEpoch();
-   if (qAbs(diff) < 30000) return DATE_PROXIMITY_NOW;
-   else if (qAbs(diff) < 3600000) return DATE_PROXIMITY_HOUR;
-
-   // does it happen today?
-   if ((now_year == time_year) && (now_month == time_month) && (now_day == time_day)) {
-       return DATE_PROXIMITY_TODAY;
-   }
-
-   // did it happen yesterday?
-   QDateTime yesterday(now.addDays(-1));
-   int yesterday_day = yesterday.date().day();
-   int yesterday_month = yesterday.date().month();
-   int yesterday_year = yesterday.date().year();
-   if ((yesterday_year == time_year) && (yesterday_month == time_month) && (yesterday_day == time_day)) {
-       return DATE_PROXIMITY_YESTERDAY;
-   }
-
-   // does it happen tomorrow?
-   QDateTime tomorrow(now.addDays(1));
-   int tomorrow_day = tomorrow.date().day();
-   int tomorrow_month = tomorrow.date().month();
-   int tomorrow_year = tomorrow.date().year();
-   if ((tomorrow_year == time_year) && (tomorrow_month == time_month) && (tomorrow_day == time_day)) {
-       return DATE_PROXIMITY_TOMORROW;
-   }
-
-   if (time < now) {
-       QDateTime lastWeek(now.addDays(-6));
-       QDateTime lastWeekBound(lastWeek.date(), QTime(0, 0, 0, 0));
+public:
+    DateProximity();
+    explicit DateProximity(const QDateTime &now);
+
+    // shared instance following the current time, the day boundaries are
+    // recalculated on day change, every hour or when invalidated
+    static const DateProximity &current();
+    static void invalidate();
+    // incremented on each invalidation, so local time representations cached
+    // by the users can be dropped
+    static int generation();
+
+    qint64 now() const
+    {
+        return m_now;
+    }
+    date_proximity_t proximity(qint64 time) const;
+
+private:
+    qint64 m_now;
+    qint64 m_updated;
+    qint64 m_lastWeek;
+    qint64 m_yesterday;
+    qint64 m_today;
+    qint64 m_tomorrow;
+    qint64 m_dayAfterTomorrow;
+    qint64 m_nextWeek;
+};
 
-       // does it happen last week?
-       if (time >= lastWeekBound) {
-           return DATE_PROXIMITY_LAST_WEEK;
-       }
-       return DATE_PROXIMITY_FAR_BACK;
-   } else {
-       QDateTime nextWeek(now.addDays(6));
-       QDateTime nextWeekBound(nextWeek.date(), QTime(23, 59, 59, 999));
-
-       // does it happen this week?
-       if (time <= nextWeekBound) {
-           return DATE_PROXIMITY_NEXT_WEEK;
-       }
-       return DATE_PROXIMITY_FAR_FORWARD;
-   }
+inline date_proximity_t getDateProximity(const QDateTime& now, const QDateTime& time)
+{
+    return DateProximity(now).proximity(time.toMSecsSinceEpoch());
 }
 
 inline LiveTimer::Frequency frequencyForProximity(date_proximity_t proximity) {
@@ -23,6 +23,7 @@
 
 #include <stdexcept>
 
+#include <QtCore/QElapsedTimer>
 #include <QtQml/QQmlContext>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlExtensionPlugin>
@@ -107,6 +108,116 @@ UT_NAMESPACE_BEGIN
 static const QString notInstantiatable = QStringLiteral("Not instantiatable");
 static const char engineProperty[] = "__ubuntu_toolkit_plugin_data";
 
+/*
+ * Time spent in the different phases of the module definition and initialization.
+ * The breakdown is logged as generic events when the application monitor logs them.
+ */
+class StartupTiming
+{
+public:
+    void start()
+    {
+        m_timer.start();
+    }
+
+    void lap(const char *phase)
+    {
+        if (m_count < maxPhases) {
+            m_phases[m_count].name = phase;
+            m_phases[m_count].time = m_timer.nsecsElapsed();
+            m_count++;
+        }
+        m_timer.start();
+    }
+
+    void log(UMApplicationMonitor *monitor)
+    {
+        const quint32 id = monitor->registerGenericEvent();
+        for (int i = 0; i < m_count; i++) {
+            char string[UMGenericEvent::maxStringSize];
+            const int size = qsnprintf(string, sizeof(string), "UbuntuToolkit startup %s: %.3f ms",
+                                       m_phases[i].name, m_phases[i].time / 1000000.0);
+            if (!monitor->logGenericEvent(
+                    id, string, qMin<quint32>(size + 1, UMGenericEvent::maxStringSize))) {
+                break;
+            }
+        }
+        m_count = 0;
+    }
+
+private:
+    static const int maxPhases = 8;
+    struct {
+        const char *name;
+        qint64 time;
+    } m_phases[maxPhases];
+    int m_count = 0;
+    QElapsedTimer m_timer;
+};
+static StartupTiming startupTiming;
+
+static bool applicationMonitorRequested()
+{
+    return qEnvironmentVariableIsSet("UC_METRICS_LOGGING_FILTER")
+        || qEnvironmentVariableIsSet("UC_METRICS_LOGGING")
+        || qEnvironmentVariableIsSet("UC_METRICS_OVERLAY");
+}
+
+static UMApplicationMonitor* setupApplicationMonitor()
+{
+    UMApplicationMonitor* applicationMonitor = UMApplicationMonitor::instance();
+    const QString metricsLoggingFilter =
+        QString::fromLocal8Bit(qgetenv("UC_METRICS_LOGGING_FILTER"));
+    if (!metricsLoggingFilter.isNull()) {
+        QStringList filterList =
+            metricsLoggingFilter.split(QStringLiteral(","), QString::SkipEmptyParts);
+        UMApplicationMonitor::LoggingFilters filter = 0;
+        const int size = filterList.size();
+        for (int i = 0; i < size; ++i) {
+            if (filterList[i] == QStringLiteral("*")) {
+                filter |= UMApplicationMonitor::AllEvents;
+                break;
+            } else if (filterList[i] == QStringLiteral("window")) {
+                filter |= UMApplicationMonitor::WindowEvent;
+            } else if (filterList[i] == QStringLiteral("process")) {
+                filter |= UMApplicationMonitor::ProcessEvent;
+            } else if (filterList[i] == QStringLiteral("frame")) {
+                filter |= UMApplicationMonitor::FrameEvent;
+            } else if (filterList[i] == QStringLiteral("generic")) {
+                filter |= UMApplicationMonitor::GenericEvent;
+            } else if (filterList[i] == QStringLiteral("input")) {
+                filter |= UMApplicationMonitor::InputEvent;
+            } else if (filterList[i] == QStringLiteral("jank")) {
+                filter |= UMApplicationMonitor::JankEvent;
+            }
+        }
+        applicationMonitor->setLoggingFilter(filter);
+    }
+    const QByteArray metricsLogging = qgetenv("UC_METRICS_LOGGING");
+    if (!metricsLogging.isNull()) {
+        UMLogger* logger;
+        if (metricsLogging.isEmpty() || metricsLogging == "stdout") {
+            logger = new UMFileLogger(stdout);
+#if defined(Q_OS_LINUX)
+        } else if (metricsLogging == "lttng") {
+            logger = new UMLTTNGLogger();
+#endif  // defined(Q_OS_LINUX)
+        } else {
+            logger = new UMFileLogger(QString::fromLocal8Bit(metricsLogging));
+        }
+        if (logger->isOpen()) {
+            applicationMonitor->installLogger(logger);
+            applicationMonitor->setLogging(true);
+        } else {
+            delete logger;
+        }
+    }
+    if (qEnvironmentVariableIsSet("UC_METRICS_OVERLAY")) {
+        applicationMonitor->setOverlay(true);
+    }
+    return applicationMonitor;
+}
+
 /******************************************************************************
  * UbuntuToolkitModule
  */
@@ -181,17 +292,22 @@ void UbuntuToolkitModule::initializeContextProperties(QQmlEngine *engine)
     UCApplication::instance()->setContext(context);
 
     context->setContextProperty(QStringLiteral("units"), UCUnits::instance());
-    ContextPropertyChangeListener *unitsChangeListener =
-        new ContextPropertyChangeListener(context, QStringLiteral("units"));
-    QObject::connect(UCUnits::instance(), SIGNAL(gridUnitChanged()),
-                     unitsChangeListener, SLOT(updateContextProperty()));
-
     // register FontUtils
     context->setContextProperty(QStringLiteral("FontUtils"), UCFontUtils::instance());
-    ContextPropertyChangeListener *fontUtilsListener =
-        new ContextPropertyChangeListener(context, QStringLiteral("FontUtils"));
-    QObject::connect(UCUnits::instance(), SIGNAL(gridUnitChanged()),
-                     fontUtilsListener, SLOT(updateContextProperty()));
+
+    // Bindings calling units.gu()/dp() or FontUtils track the grid unit of the engine
+    // owning the units singleton themselves, so only the bindings actually depending
+    // on it get re-evaluated. Other engines still need the context properties reset.
+    if (UCUnits::instance()->parent() != engine) {
+        ContextPropertyChangeListener *unitsChangeListener =
+            new ContextPropertyChangeListener(context, QStringLiteral("units"));
+        QObject::connect(UCUnits::instance(), SIGNAL(gridUnitChanged()),
+                         unitsChangeListener, SLOT(updateContextProperty()));
+        ContextPropertyChangeListener *fontUtilsListener =
+            new ContextPropertyChangeListener(context, QStringLiteral("FontUtils"));
+        QObject::connect(UCUnits::instance(), SIGNAL(gridUnitChanged()),
+                         fontUtilsListener, SLOT(updateContextProperty()));
+    }
 
     // Make the context property 'window' available even before there is a window,
     // so that in QML we do not have to check whether 'window' is defined, and no new
@@ -255,6 +371,7 @@ QUrl UbuntuToolkitModule::baseUrl(QQmlEngine *engine)
 
 void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &pluginBaseUrl)
 {
+    startupTiming.start();
     UbuntuToolkitModule *module = create(engine, pluginBaseUrl);
 
     // Register private types.
@@ -268,15 +385,17 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
 
     //FIXME: move to a more generic location, i.e StyledItem or QuickUtils
     qmlRegisterSimpleSingletonType<UCScrollbarUtils>(privateUri, 1, 3, "PrivateScrollbarUtils");
+    startupTiming.lap("private types");
 
     // allocate all context property objects prior we register them
     initializeContextProperties(engine);
 
     HapticsProxy::instance(engine);
+    startupTiming.lap("context properties");
 
     engine->addImageProvider(QLatin1String("scaling"), new UCScalingImageProvider);
 
-    // register icon provider
+    // register icon provider, the icon theme is loaded on the first request
     engine->addImageProvider(QLatin1String("theme"), new UnityThemeIconProvider);
 
     // Necessary for Screen.orientation (from import QtQuick.Window 2.0) to work
@@ -287,62 +406,25 @@ void UbuntuToolkitModule::initializeModule(QQmlEngine *engine, const QUrl &plugi
             Qt::InvertedLandscapeOrientation));
 
     module->registerWindowContextProperty();
-
-    // Application monitoring.
-    UMApplicationMonitor* applicationMonitor = UMApplicationMonitor::instance();
-    const QString metricsLoggingFilter =
-        QString::fromLocal8Bit(qgetenv("UC_METRICS_LOGGING_FILTER"));
-    if (!metricsLoggingFilter.isNull()) {
-        QStringList filterList =
-            metricsLoggingFilter.split(QStringLiteral(","), QString::SkipEmptyParts);
-        UMApplicationMonitor::LoggingFilters filter = 0;
-        const int size = filterList.size();
-        for (int i = 0; i < size; ++i) {
-            if (filterList[i] == QStringLiteral("*")) {
-                filter |= UMApplicationMonitor::AllEvents;
-                break;
-            } else if (filterList[i] == QStringLiteral("window")) {
-                filter |= UMApplicationMonitor::WindowEvent;
-            } else if (filterList[i] == QStringLiteral("process")) {
-                filter |= UMApplicationMonitor::ProcessEvent;
-            } else if (filterList[i] == QStringLiteral("frame")) {
-                filter |= UMApplicationMonitor::FrameEvent;
-            } else if (filterList[i] == QStringLiteral("generic")) {
-                filter |= UMApplicationMonitor::GenericEvent;
-            }
-        }
-        applicationMonitor->setLoggingFilter(filter);
-    }
-    const QByteArray metricsLogging = qgetenv("UC_METRICS_LOGGING");
-    if (!metricsLogging.isNull()) {
-        UMLogger* logger;
-        if (metricsLogging.isEmpty() || metricsLogging == "stdout") {
-            logger = new UMFileLogger(stdout);
-#if defined(Q_OS_LINUX)
-        } else if (metricsLogging == "lttng") {
-            logger = new UMLTTNGLogger();
-#endif  // defined(Q_OS_LINUX)
-        } else {
-            logger = new UMFileLogger(QString::fromLocal8Bit(metricsLogging));
-        }
-        if (logger->isOpen()) {
-            applicationMonitor->installLogger(logger);
-            applicationMonitor->setLogging(true);
-        } else {
-            delete logger;
-        }
-    }
-    if (qEnvironmentVariableIsSet("UC_METRICS_OVERLAY")) {
-        applicationMonitor->setOverlay(true);
-    }
+    startupTiming.lap("image providers, window");
 
     // register performance monitor
     engine->rootContext()->setContextProperty(
         QStringLiteral("performanceMonitor"), new UCPerformanceMonitor(engine));
+    startupTiming.lap("performance monitor");
+
+    // Application monitoring. The monitor is only instantiated when the environment
+    // asks for it, applications and the Metrics plugin instantiate it otherwise.
+    if (applicationMonitorRequested()) {
+        UMApplicationMonitor* applicationMonitor = setupApplicationMonitor();
+        startupTiming.lap("application monitor");
+        startupTiming.log(applicationMonitor);
+    }
 }
 
 void UbuntuToolkitModule::defineModule()
 {
+    startupTiming.start();
     const char *uri = "Ubuntu.Components";
     // register 0.1 for backward compatibility
     registerTypesToVersion(uri, 0, 1);
@@ -402,6 +484,7 @@ void UbuntuToolkitModule::defineModule()
     qmlRegisterType<UCMainViewBase>(uri, 1, 3, "MainViewBase");
     qmlRegisterType<ActionList>(uri, 1, 3, "ActionList");
     qmlRegisterType<ExclusiveGroup>(uri, 1, 3, "ExclusiveGroup");
+    startupTiming.lap("type registration");
 }
 
 void UbuntuToolkitModule::undefineModule()
@@ -41,6 +41,11 @@ Q_LOGGING_CATEGORY(ucBottomEdge, "ubuntu.components.BottomEdge", QtMsgType::QtWa
 
 UT_NAMESPACE_BEGIN
 
+// number of inactive regions keeping their content loaded
+static const int defaultRetainedRegions = 2;
+// how far ahead in time the drag is followed when predicting the next region, in ms
+static const qreal predictionInterval = 250.0;
+
 UCBottomEdgePrivate::UCBottomEdgePrivate()
     : UCStyledItemBasePrivate()
     , defaultRegion(new DefaultRegion(nullptr))
@@ -48,14 +53,24 @@ UCBottomEdgePrivate::UCBottomEdgePrivate()
     , hint(new UCBottomEdgeHint)
     , bottomPanel(Q_NULLPTR)
     , previousDistance(0.0)
+    , velocityDistance(0.0)
+    , dragVelocity(0.0)
     , dragProgress(0.)
     , status(UCBottomEdge::Hidden)
     , operationStatus(Idle)
     , dragDirection(UCBottomEdge::Undefined)
+    , retainedRegionsBudget(defaultRetainedRegions)
     , defaultRegionsReset(false)
     , mousePressed(false)
     , preloadContent(false)
 {
+    if (qEnvironmentVariableIsSet("UC_BOTTOMEDGE_RETAINED_REGIONS")) {
+        bool ok;
+        int value = qgetenv("UC_BOTTOMEDGE_RETAINED_REGIONS").toInt(&ok);
+        if (ok && value >= 0) {
+            retainedRegionsBudget = value;
+        }
+    }
 }
 
 void UCBottomEdgePrivate::init()
@@ -151,6 +166,9 @@ void UCBottomEdgePrivate::clearRegions(bool destroy)
     if (!defaultRegionsReset) {
         return;
     }
+    while (!retainedRegions.isEmpty()) {
+        releaseRegionContent(retainedRegions.first());
+    }
     if (destroy) {
         qDeleteAll(regions);
     }
@@ -208,6 +226,7 @@ void UCBottomEdgePrivate::updateProgressionStates(qreal distance)
     // refresh drag progress
     setDragProgress(distance / q->height());
 
+    trackDragVelocity(distance);
     detectDirection(distance);
     if (isLocked()) {
         // there is an operation ongoing, do not update drag and activeRegion
@@ -234,6 +253,7 @@ void UCBottomEdgePrivate::updateProgressionStates(qreal distance)
     if (newActive != activeRegion) {
         setActiveRegion(newActive);
     }
+    predictRegion();
 }
 
 // set the active region
@@ -242,10 +262,16 @@ bool UCBottomEdgePrivate::setActiveRegion(UCBottomEdgeRegion *region)
     if (activeRegion == region) {
         return false;
     }
-    if (activeRegion) {
-        activeRegion->exit();
-    }
+    // switch before exiting, so the exited region's content gets retained
+    UCBottomEdgeRegion *previousRegion = activeRegion;
     activeRegion = region;
+    // the active region's content is not subject of the retention budget
+    if (activeRegion && retainedRegions.removeOne(activeRegion)) {
+        UCBottomEdgeRegionPrivate::get(activeRegion)->retained = false;
+    }
+    if (previousRegion) {
+        previousRegion->exit();
+    }
     if (activeRegion) {
         activeRegion->enter();
     }
@@ -272,6 +298,98 @@ void UCBottomEdgePrivate::detectDirection(qreal currentDistance)
     setDragDirection(newDirection);
 }
 
+// follows the drag speed in pixels per millisecond, positive when dragged upwards
+void UCBottomEdgePrivate::trackDragVelocity(qreal distance)
+{
+    if (!velocityTimer.isValid()) {
+        velocityTimer.start();
+        velocityDistance = distance;
+        dragVelocity = 0.0;
+        return;
+    }
+    qint64 elapsed = velocityTimer.elapsed();
+    if (elapsed < 1) {
+        return;
+    }
+    velocityTimer.restart();
+    // smooth out the jitter of the individual move events
+    qreal velocity = (distance - velocityDistance) / elapsed;
+    dragVelocity = (dragVelocity + velocity) / 2.0;
+    velocityDistance = distance;
+}
+
+// starts loading the content of the region the drag is heading to, so the
+// content is ready by the time the region is entered or committed
+void UCBottomEdgePrivate::predictRegion()
+{
+    Q_Q(UCBottomEdge);
+    if (preloadContent || retainedRegionsBudget <= 0 || q->height() <= 0.0) {
+        return;
+    }
+    // follow the velocity only if it agrees with the detected drag direction
+    bool upwards = (dragDirection == UCBottomEdge::Upwards);
+    if (dragDirection == UCBottomEdge::Undefined || upwards != (dragVelocity > 0.0)) {
+        return;
+    }
+    qreal predictedProgress = qBound<qreal>(0.0, dragProgress + dragVelocity * predictionInterval / q->height(), 1.0);
+    Q_FOREACH(UCBottomEdgeRegion *region, regions) {
+        if (region->contains(predictedProgress)) {
+            if (region != activeRegion) {
+                LOG << "PREDICTED REGION" << region->objectName() << predictedProgress;
+                retainRegionContent(region);
+            }
+            return;
+        }
+    }
+}
+
+// keeps the content of an inactive region and loads it if not yet there; the
+// least recently used regions are discarded when running out of the budget.
+// The content is incubated asynchronously, in the time slices the window's
+// incubation controller gives between frames.
+void UCBottomEdgePrivate::retainRegionContent(UCBottomEdgeRegion *region)
+{
+    if (region == defaultRegion || region == activeRegion) {
+        // default region content is never discarded, active one is in use
+        return;
+    }
+    UCBottomEdgeRegionPrivate *regionPrivate = UCBottomEdgeRegionPrivate::get(region);
+    if (retainedRegionsBudget <= 0) {
+        regionPrivate->discardRegionContent();
+        return;
+    }
+    retainedRegions.removeOne(region);
+    retainedRegions.prepend(region);
+    regionPrivate->retained = true;
+    if (!regionPrivate->contentItem && !regionPrivate->isLoading()) {
+        regionPrivate->loadRegionContent();
+    }
+    while (retainedRegions.size() > retainedRegionsBudget) {
+        releaseRegionContent(retainedRegions.last());
+    }
+}
+
+// discards the retained content of the region
+void UCBottomEdgePrivate::releaseRegionContent(UCBottomEdgeRegion *region)
+{
+    retainedRegions.removeOne(region);
+    UCBottomEdgeRegionPrivate *regionPrivate = UCBottomEdgeRegionPrivate::get(region);
+    regionPrivate->retained = false;
+    if (region != activeRegion) {
+        LOG << "RELEASE REGION CONTENT" << region->objectName();
+        regionPrivate->discardRegionContent();
+    }
+}
+
+// drops the retention bookkeeping without touching the content
+void UCBottomEdgePrivate::forgetRetainedRegions()
+{
+    Q_FOREACH(UCBottomEdgeRegion *region, retainedRegions) {
+        UCBottomEdgeRegionPrivate::get(region)->retained = false;
+    }
+    retainedRegions.clear();
+}
+
 // internal dragDirection property setter
 void UCBottomEdgePrivate::setDragDirection(UCBottomEdge::DragDirection direction)
 {
@@ -289,6 +407,9 @@ void UCBottomEdgePrivate::setDragDirection(UCBottomEdge::DragDirection direction
 // proceed with drag completion action
 void UCBottomEdgePrivate::onDragEnded()
 {
+    velocityTimer.invalidate();
+    dragVelocity = 0.0;
+
     // collapse if we drag downwards, or not in any active region and we did not pass 30% of the BottomEdge height
     LOG << "direction:" << dragDirection << ", activeRegion?" << activeRegion << ", dragProgress:" << dragProgress;
     if (dragDirection == UCBottomEdge::Downwards || (activeRegion && !activeRegion->canCommit(dragProgress))) {
@@ -1109,6 +1230,8 @@ void UCBottomEdge::setPreloadContent(bool value)
         return;
     }
     d->preloadContent = value;
+    // preloading keeps every region's content, no need to retain any
+    d->forgetRetainedRegions();
 
     if (d->preloadContent) {
         // we load all region's content, but we skip teh default one,
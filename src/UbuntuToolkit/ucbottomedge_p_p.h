@@ -21,6 +21,8 @@
 
 #include <UbuntuToolkit/private/ucbottomedge_p.h>
 
+#include <QtCore/QElapsedTimer>
+
 #include <UbuntuToolkit/private/ucstyleditembase_p_p.h>
 #include <UbuntuToolkit/private/ucaction_p.h>
 
@@ -61,6 +63,13 @@ public:
     void onDragEnded();
     void commit(qreal to);
 
+    // region content prediction and retention
+    void trackDragVelocity(qreal distance);
+    void predictRegion();
+    void retainRegionContent(UCBottomEdgeRegion *region);
+    void releaseRegionContent(UCBottomEdgeRegion *region);
+    void forgetRetainedRegions();
+
     // panel positioning
     void setDragProgress(qreal position);
     // internal setters
@@ -81,8 +90,13 @@ public:
     UCBottomEdgeRegion *activeRegion;
     UCBottomEdgeHint *hint;
     UCBottomEdgeStyle *bottomPanel;
+    // inactive regions keeping their content, most recently used first
+    QList<UCBottomEdgeRegion*> retainedRegions;
+    QElapsedTimer velocityTimer;
 
     qreal previousDistance;
+    qreal velocityDistance;
+    qreal dragVelocity;
     qreal dragProgress;
     UCBottomEdge::Status status;
 
@@ -94,6 +108,7 @@ public:
     };
     OperationStatus operationStatus;
     UCBottomEdge::DragDirection dragDirection;
+    int retainedRegionsBudget;
 
     bool defaultRegionsReset:1;
     bool mousePressed:1;
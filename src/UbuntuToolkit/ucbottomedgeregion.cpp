@@ -34,6 +34,7 @@ UCBottomEdgeRegionPrivate::UCBottomEdgeRegionPrivate()
     , to(-1.0)
     , enabled(true)
     , active(false)
+    , retained(false)
 {
 }
 
@@ -170,7 +171,11 @@ void UCBottomEdgeRegion::enter()
             LOG << "SET REGION CONTENT" << objectName();
             UCBottomEdgePrivate::get(d->bottomEdge)->setCurrentContent();
         }
-    } else {
+    } else if (d->contentItem) {
+        // content retained from a previous visit or predicted by the drag
+        LOG << "SET RETAINED REGION CONTENT" << objectName();
+        UCBottomEdgePrivate::get(d->bottomEdge)->setCurrentContent();
+    } else if (!d->isLoading()) {
         // initiate loading, component has priority
         d->loadRegionContent();
     }
@@ -186,14 +191,11 @@ void UCBottomEdgeRegion::exit()
     LOG << "EXIT REGION" << objectName();
     UCBottomEdgePrivate::get(d->bottomEdge)->resetCurrentContent(nullptr);
 
-    // then cleanup
-    if (!d->contentItem) {
-        return;
-    }
-    LOG << "RESET REGION CONTENT" << objectName();
+    // then keep the content (or its loading) for a while, the drag may return
+    // into the region; the BottomEdge discards it once out of the budget
     if (!d->bottomEdge->preloadContent()) {
-        LOG << "DISCARD REGION CONTENT" << objectName();
-        d->discardRegionContent();
+        LOG << "RETAIN REGION CONTENT" << objectName();
+        UCBottomEdgePrivate::get(d->bottomEdge)->retainRegionContent(this);
     }
 }
 
@@ -238,6 +240,12 @@ void UCBottomEdgeRegionPrivate::loadContent(LoadingType type)
     }
 }
 
+bool UCBottomEdgeRegionPrivate::isLoading()
+{
+    AsyncLoader::LoadingStatus status = loader.status();
+    return status > AsyncLoader::Null && status < AsyncLoader::Ready;
+}
+
 void UCBottomEdgeRegionPrivate::discardRegionContent()
 {
     loader.reset();
@@ -256,7 +264,7 @@ void UCBottomEdgeRegionPrivate::onLoaderStatusChanged(AsyncLoader::LoadingStatus
         // if we are no longer active, no need to continue, and discard content
         // this may occur when the component was still in Compiling state while
         // the region was exited, therefore reset() could not cancel the operation.
-        if (!active && !bottomEdge->preloadContent()) {
+        if (!active && !retained && !bottomEdge->preloadContent()) {
             LOG << "DELETE REGION CONTENT" << q_func()->objectName();
             object->deleteLater();
             return;
@@ -307,6 +315,8 @@ void UCBottomEdgeRegion::setEnabled(bool enabled)
             } else {
                 d->loadRegionContent();
             }
+        } else if (!d->enabled && d->retained) {
+            UCBottomEdgePrivate::get(d->bottomEdge)->releaseRegionContent(this);
         }
     }
 
@@ -385,6 +395,9 @@ void UCBottomEdgeRegion::setUrl(const QUrl &url)
     // invoke loader if the preload is set
     if (d->bottomEdge && (d->bottomEdge->preloadContent()) && d->url.isValid()) {
         d->loadContent(UCBottomEdgeRegionPrivate::LoadingUrl);
+    } else if (d->bottomEdge && d->retained) {
+        // drop the content retained from the previous source
+        UCBottomEdgePrivate::get(d->bottomEdge)->releaseRegionContent(this);
     }
 }
 
@@ -411,6 +424,9 @@ void UCBottomEdgeRegion::setComponent(QQmlComponent *component)
     // invoke loader if the preload is set
     if (d->bottomEdge && d->bottomEdge->preloadContent() && d->component) {
         d->loadContent(UCBottomEdgeRegionPrivate::LoadingComponent);
+    } else if (d->bottomEdge && d->retained) {
+        // drop the content retained from the previous source
+        UCBottomEdgePrivate::get(d->bottomEdge)->releaseRegionContent(this);
     }
 }
 
@@ -48,6 +48,7 @@ public:
     virtual void loadRegionContent();
     virtual void discardRegionContent();
     void loadContent(LoadingType type);
+    bool isLoading();
 
     void onLoaderStatusChanged(AsyncLoader::LoadingStatus,QObject*);
 
@@ -60,6 +61,7 @@ public:
     qreal to;
     bool enabled:1;
     bool active:1;
+    bool retained:1;
 };
 
 class DefaultRegionPrivate;
@@ -28,6 +28,7 @@ class UBUNTUTOOLKIT_EXPORT UCInverseMouse : public UCMouse {
     Q_OBJECT
 public:
     explicit UCInverseMouse(QObject *parent = 0);
+    ~UCInverseMouse();
 
     static UCInverseMouse *qmlAttachedProperties(QObject *owner);
 
@@ -45,6 +46,12 @@ protected:
     bool hasAttachedFilter(QQuickItem *item) override;
     bool pointInOSK(const QPointF &point);
     bool contains(QMouseEvent *mouse);
+
+private Q_SLOTS:
+    void updateDispatcher();
+
+private:
+    QPointer<QQuickWindow> m_dispatcherWindow;
 };
 
 UT_NAMESPACE_END
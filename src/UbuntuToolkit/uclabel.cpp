@@ -16,6 +16,9 @@
 
 #include "label_p.h"
 
+#include <QtCore/QCoreApplication>
+#include <QtGui/QGuiApplication>
+
 #include "quickutils_p.h"
 #include "ucfontutils_p.h"
 #include "uctheme_p.h"
@@ -39,6 +42,53 @@ UCLabelPrivate::UCLabelPrivate(UCLabel *qq, UCLabel::ColorProviderFunc func)
 {
 }
 
+// Fonts shared by the labels which did not customize their font, so a label
+// doesn't build its own font on creation and on grid unit changes. The fonts are
+// rebuilt when the grid unit or the application font changes, and released
+// together with the application so that no font outlives the font database.
+struct DefaultFonts
+{
+    QFont fonts[UCLabel::XLarge + 1];
+    QFont applicationFont;
+    float gridUnit = 0.0f;
+};
+Q_GLOBAL_STATIC(DefaultFonts, defaultFonts)
+
+static void releaseDefaultFonts()
+{
+    if (defaultFonts.exists()) {
+        *defaultFonts = DefaultFonts();
+    }
+}
+
+const QFont &UCLabelPrivate::defaultFont(UCLabel::TextSize size)
+{
+    DefaultFonts *cache = defaultFonts;
+
+    const float currentGridUnit = UCUnits::instance()->gridUnit();
+    const QFont currentApplicationFont = QGuiApplication::font();
+    if (cache->gridUnit != currentGridUnit || cache->applicationFont != currentApplicationFont) {
+        // Post routines are dropped once called, register again for each application.
+        if (cache->gridUnit == 0.0f) {
+            qAddPostRoutine(releaseDefaultFonts);
+        }
+        cache->gridUnit = currentGridUnit;
+        cache->applicationFont = currentApplicationFont;
+        const float sizes[] = {
+            UCFontUtils::xxSmallScale, UCFontUtils::xSmallScale, UCFontUtils::smallScale,
+            UCFontUtils::mediumScale, UCFontUtils::largeScale, UCFontUtils::xLargeScale
+        };
+        for (int i = UCLabel::XxSmall; i <= UCLabel::XLarge; i++) {
+            QFont font;
+            font.setPixelSize(qRound(sizes[i] * UCUnits::instance()->dp(UCFontUtils::fontUnits)));
+            font.setFamily(QStringLiteral("Ubuntu"));
+            font.setWeight(QFont::Light);
+            cache->fonts[i] = font;
+        }
+    }
+    return cache->fonts[size];
+}
+
 void UCLabelPrivate::updatePixelSize()
 {
     if (flags & PixelSizeSet) {
@@ -46,6 +96,10 @@ void UCLabelPrivate::updatePixelSize()
     }
 
     Q_Q(UCLabel);
+    if (!(flags & FontSet)) {
+        q->setFont(defaultFont(textSize));
+        return;
+    }
     const float sizes[] = {
         UCFontUtils::xxSmallScale, UCFontUtils::xSmallScale, UCFontUtils::smallScale,
         UCFontUtils::mediumScale, UCFontUtils::largeScale, UCFontUtils::xLargeScale
@@ -134,10 +188,6 @@ void UCLabelPrivate::init()
     q->postThemeChanged();
 
     updatePixelSize();
-    QFont defaultFont = q->font();
-    defaultFont.setFamily(QStringLiteral("Ubuntu"));
-    defaultFont.setWeight(QFont::Light);
-    q->setFont(defaultFont);
     updateRenderType();
 
     QObject::connect(UCUnits::instance(), SIGNAL(gridUnitChanged()), q, SLOT(updateRenderType()));
@@ -207,6 +257,12 @@ void UCLabel::setFont2(const QFont &font)
     if (this->font().pixelSize() != font.pixelSize()) {
         d->flags |= UCLabelPrivate::PixelSizeSet;
     }
+    // labels with customized fonts no longer share the default font
+    if (font == UCLabelPrivate::defaultFont(d->textSize)) {
+        d->flags &= ~UCLabelPrivate::FontSet;
+    } else {
+        d->flags |= UCLabelPrivate::FontSet;
+    }
     QQuickText::setFont(font);
 }
 
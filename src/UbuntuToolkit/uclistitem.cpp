@@ -22,6 +22,8 @@
 #include <QtGui/QStyleHints>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlInfo>
+#include <QtQml/private/qqmldata_p.h>
+#include <QtQml/private/qqmlpropertycache_p.h>
 #include <QtQuick/private/qquickanimation_p.h>
 #include <QtQuick/private/qquickbehavior_p.h>
 #include <QtQuick/private/qquickflickable_p.h>
@@ -58,18 +60,26 @@ public:
         , listItem(0)
     {}
 
+    static inline UCListItemDividerPrivate *get(UCListItemDivider *that)
+    {
+        Q_ASSERT(that);
+        return that->d_func();
+    }
+
     bool colorFromChanged:1;
     bool colorToChanged:1;
     QColor colorFrom;
     QColor colorTo;
-    QGradientStops gradient;
     UCListItem *listItem;
 };
 
+/*
+ * The divider has no contents of its own, it is painted by the ListItem as part
+ * of its node, using the divider's geometry and colors.
+ */
 UCListItemDivider::UCListItemDivider(UCListItem *parent)
     : QQuickItem(*(new UCListItemDividerPrivate), parent)
 {
-    setFlag(ItemHasContents);
 }
 UCListItemDivider::~UCListItemDivider()
 {
@@ -110,48 +120,30 @@ void UCListItemDivider::paletteChanged()
         if (!d->colorToChanged) {
             d->colorTo = themeColor;
         }
-        updateGradient();
+        updateListItem();
     }
 }
 
-void UCListItemDivider::updateGradient()
+void UCListItemDivider::updateListItem()
 {
     Q_D(UCListItemDivider);
-    d->gradient.clear();
-    if (height() > UCUnits::instance()->dp(1)) {
-        d->gradient.append(QGradientStop(0.0, d->colorFrom));
-        d->gradient.append(QGradientStop(0.49, d->colorFrom));
-        d->gradient.append(QGradientStop(0.5, d->colorTo));
-        d->gradient.append(QGradientStop(1.0, d->colorTo));
+    if (d->listItem) {
+        d->listItem->update();
     }
-    update();
 }
 
-QSGNode *UCListItemDivider::updatePaintNode(QSGNode *node, UpdatePaintNodeData *data)
+void UCListItemDivider::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
-    Q_UNUSED(data);
-    Q_D(UCListItemDivider);
-    QSGRectangleNode *dividerNode = static_cast<QSGRectangleNode*>(node);
-    if (!dividerNode) {
-        dividerNode = d->sceneGraphContext()->createRectangleNode();
-    }
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    updateListItem();
+}
 
-    UCListItemPrivate *pListItem = UCListItemPrivate::get(d->listItem);
-    bool lastItem = pListItem->countOwner ? (pListItem->index() == (pListItem->countOwner->property("count").toInt() - 1)): false;
-    if (!lastItem && ((d->colorFrom.alphaF() >= (1.0f / 255.0f)) || (d->colorTo.alphaF() >= (1.0f / 255.0f)))) {
-        dividerNode->setRect(boundingRect());
-        if (d->gradient.size() > 0) {
-            dividerNode->setGradientStops(d->gradient);
-        } else {
-            dividerNode->setColor(d->colorFrom);
-        }
-        dividerNode->update();
-        return dividerNode;
-    } else if (node) {
-        // delete the node
-        delete node;
+void UCListItemDivider::itemChange(ItemChange change, const ItemChangeData &data)
+{
+    QQuickItem::itemChange(change, data);
+    if (change == ItemVisibleHasChanged || change == ItemOpacityHasChanged) {
+        updateListItem();
     }
-    return 0;
 }
 
 QColor UCListItemDivider::colorFrom() const
@@ -167,7 +159,7 @@ void UCListItemDivider::setColorFrom(const QColor &color)
     }
     d->colorFrom = color;
     d->colorFromChanged = true;
-    updateGradient();
+    updateListItem();
     Q_EMIT colorFromChanged();
 }
 
@@ -184,7 +176,7 @@ void UCListItemDivider::setColorTo(const QColor &color)
     }
     d->colorTo = color;
     d->colorToChanged = true;
-    updateGradient();
+    updateListItem();
     Q_EMIT colorToChanged();
 }
 
@@ -358,6 +350,28 @@ bool UCListItemPrivate::loadStyleItem(bool animated)
     return true;
 }
 
+/*
+ * The ListItems created from the same delegate share the property cache, so the
+ * import version is resolved only once per delegate type within a view.
+ */
+quint16 UCListItemPrivate::importVersion(QObject *object)
+{
+    QQmlData *data = QQmlData::get(object);
+    UCViewItemsAttachedPrivate *pAttached = UCViewItemsAttachedPrivate::get(parentAttached);
+    if (!pAttached || !data || !data->propertyCache) {
+        return UCStyledItemBasePrivate::importVersion(object);
+    }
+    if (pAttached->versionPropertyCache != data->propertyCache) {
+        if (pAttached->versionPropertyCache) {
+            pAttached->versionPropertyCache->release();
+        }
+        pAttached->versionPropertyCache = data->propertyCache;
+        pAttached->versionPropertyCache->addref();
+        pAttached->delegateVersion = UCStyledItemBasePrivate::importVersion(object);
+    }
+    return pAttached->delegateVersion;
+}
+
 // called when units size changes
 void UCListItemPrivate::_q_updateSize()
 {
@@ -427,11 +441,17 @@ void UCListItemPrivate::setSwiped(bool swiped)
     }
     this->swiped = swiped;
     Q_Q(UCListItem);
-    QQuickWindow *window = q->window();
     if (swiped) {
-        window->installEventFilter(q);
+        filteredWindow = q->window();
+        if (filteredWindow) {
+            filteredWindow->installEventFilter(q);
+        }
     } else {
-        window->removeEventFilter(q);
+        // the window may be gone already when the ListItem is released
+        if (filteredWindow) {
+            filteredWindow->removeEventFilter(q);
+            filteredWindow.clear();
+        }
         // lock contentItem left/right edges
         lockContentItem(true);
     }
@@ -494,6 +514,22 @@ void UCListItemPrivate::snapOut()
     }
 }
 
+/*
+ * Resets the interaction state of a ListItem released by its view, so the
+ * release doesn't leave event filters, timers or Flickable bindings behind
+ * until the deferred deletion of the item.
+ */
+void UCListItemPrivate::resetState()
+{
+    listenToRebind(false);
+    setHighlighted(false);
+    if (swiped) {
+        setSwiped(false);
+        contentItem->setPosition(zeroPos);
+    }
+    setContentMoving(false);
+}
+
 // emits the style signal swipeEvent()
 void UCListItemPrivate::swipeEvent(const QPointF &localPos, UCSwipeEvent::Status status)
 {
@@ -1032,8 +1068,8 @@ void UCListItem::classBegin()
 {
     UCStyledItemBase::classBegin();
     Q_D(UCListItem);
+    // also updates the divider colors
     d->_q_themeChanged();
-    d->divider->paletteChanged();
 }
 
 void UCListItem::componentComplete()
@@ -1054,7 +1090,9 @@ void UCListItem::componentComplete()
      * of items. However, if the parent item, or Flickable declares a "count" property,
      * the ListItem will take use of it!
      */
-    d->countOwner = (d->flickable && d->flickable->property("count").isValid()) ?
+    d->countOwner = (d->parentAttached && d->parentAttached->isAttachedToListView()) ?
+                d->flickable :
+                (d->flickable && d->flickable->property("count").isValid()) ?
                 d->flickable :
                 (d->parentItem && d->parentItem->property("count").isValid()) ? d->parentItem : 0;
     if (d->countOwner) {
@@ -1104,6 +1142,8 @@ void UCListItem::itemChange(ItemChange change, const ItemChangeData &data)
         } else if (data.item) {
             d->parentAttached = static_cast<UCViewItemsAttached*>(attachedViewItems(data.item, true));
         } else {
+            // released by the view, or about to be deleted
+            d->resetState();
             // mark as not ready, so no action should be performed which depends on readyness
             d->ready = false;
             // about to be deleted or reparented, disable attached
@@ -1132,6 +1172,24 @@ void UCListItem::itemChange(ItemChange change, const ItemChangeData &data)
     }
 }
 
+/*
+ * The ListItem paints its background (highlight and focus frame) and its divider
+ * in a single node, each part being a rectangle child node created only when
+ * there is something to be drawn.
+ */
+class ListItemNode : public QSGNode
+{
+public:
+    ListItemNode()
+        : QSGNode()
+        , background(Q_NULLPTR)
+        , divider(Q_NULLPTR)
+    {}
+
+    QSGRectangleNode *background;
+    QSGRectangleNode *divider;
+};
+
 QSGNode *UCListItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
 {
     Q_UNUSED(data);
@@ -1144,48 +1202,88 @@ QSGNode *UCListItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         return 0;
     }
 
-    QSGRectangleNode *rectNode = 0;
-    rectNode = static_cast<QSGRectangleNode*>(oldNode);
-    if (!rectNode) {
-        rectNode = QQuickItemPrivate::get(this)->sceneGraphContext()->createRectangleNode();
+    ListItemNode *node = static_cast<ListItemNode*>(oldNode);
+    if (!node) {
+        node = new ListItemNode;
     }
+    QSGContext *sgContext = QQuickItemPrivate::get(this)->sceneGraphContext();
     bool updateNode = false;
 
     // focus frame
     bool paintFocus = hasActiveFocus() && keyNavigationFocus();
-    rectNode->setPenWidth(paintFocus ? UCUnits::instance()->dp(2) : 0);
-    if (paintFocus) {
-        QColor penColor;
-        if (getTheme()) {
-            penColor = getTheme()->getPaletteColor(isEnabled() ? "normal" : "disabled", "focus");
+    bool paintHighlight = color.alphaF() >= (1.0f / 255.0f);
+    if (paintFocus || paintHighlight) {
+        if (!node->background) {
+            node->background = sgContext->createRectangleNode();
+            // the background stays behind the divider
+            node->prependChildNode(node->background);
+        }
+        QSGRectangleNode *rectNode = node->background;
+        rectNode->setPenWidth(paintFocus ? UCUnits::instance()->dp(2) : 0);
+        if (paintFocus) {
+            QColor penColor;
+            if (getTheme()) {
+                penColor = getTheme()->getPaletteColor(isEnabled() ? "normal" : "disabled", "focus");
+            }
+            rectNode->setPenColor(penColor);
+            rectNode->setColor(Qt::transparent);
+        }
+        rectNode->setRect(boundingRect());
+
+        // highlight color
+        if (paintHighlight) {
+            rectNode->setColor(color);
+            rectNode->setGradientStops(QGradientStops());
+            rectNode->setAntialiasing(true);
+            rectNode->setAntialiasing(false);
         }
-        rectNode->setPenColor(penColor);
-        rectNode->setColor(Qt::transparent);
+        rectNode->update();
         updateNode = true;
-    }
-    QRectF rect(boundingRect());
-    d->divider->setOpacity(paintFocus ? 0.0 : 1.0);
-    rectNode->setRect(rect);
-
-    // highlight color
-    if (color.alphaF() >= (1.0f / 255.0f)) {
-        rectNode->setColor(color);
-        rectNode->setGradientStops(QGradientStops());
-        rectNode->setAntialiasing(true);
-        rectNode->setAntialiasing(false);
+    } else if (node->background) {
+        delete node->background;
+        node->background = Q_NULLPTR;
+    }
+
+    // divider, hidden when the focus frame is painted and for the last item of a view
+    UCListItemDividerPrivate *pDivider = UCListItemDividerPrivate::get(d->divider);
+    qreal dividerOpacity = d->divider->isVisible() ? d->divider->opacity() : 0.0;
+    QColor colorFrom(pDivider->colorFrom);
+    QColor colorTo(pDivider->colorTo);
+    colorFrom.setAlphaF(colorFrom.alphaF() * dividerOpacity);
+    colorTo.setAlphaF(colorTo.alphaF() * dividerOpacity);
+    bool lastItem = d->countOwner ? (d->index() == (d->countOwner->property("count").toInt() - 1)) : false;
+    QRectF dividerRect(d->divider->position(), QSizeF(d->divider->width(), d->divider->height()));
+    if (!paintFocus && !lastItem && !dividerRect.isEmpty()
+            && ((colorFrom.alphaF() >= (1.0f / 255.0f)) || (colorTo.alphaF() >= (1.0f / 255.0f)))) {
+        if (!node->divider) {
+            node->divider = sgContext->createRectangleNode();
+            node->appendChildNode(node->divider);
+        }
+        node->divider->setRect(dividerRect);
+        if (dividerRect.height() > UCUnits::instance()->dp(1)) {
+            QGradientStops gradient;
+            gradient.append(QGradientStop(0.0, colorFrom));
+            gradient.append(QGradientStop(0.49, colorFrom));
+            gradient.append(QGradientStop(0.5, colorTo));
+            gradient.append(QGradientStop(1.0, colorTo));
+            node->divider->setGradientStops(gradient);
+        } else {
+            node->divider->setGradientStops(QGradientStops());
+            node->divider->setColor(colorFrom);
+        }
+        node->divider->update();
         updateNode = true;
+    } else if (node->divider) {
+        delete node->divider;
+        node->divider = Q_NULLPTR;
     }
 
-    // update
-    if (updateNode) {
-        rectNode->update();
-    } else {
-        // delete node, this will delete the divider node as well
-        delete rectNode;
-        rectNode = 0;
+    if (!updateNode) {
+        // nothing to paint, this will delete the child nodes as well
+        delete node;
+        node = Q_NULLPTR;
     }
-    oldNode = rectNode;
-    return oldNode;
+    return node;
 }
 
 // grabs the left mouse button event by turning highlight on, and triggering
@@ -164,10 +164,11 @@ Q_SIGNALS:
     void colorToChanged();
 
 protected:
-    QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data) override;
+    void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+    void itemChange(ItemChange change, const ItemChangeData &data) override;
 
 private:
-    void updateGradient();
+    void updateListItem();
     QColor colorFrom() const;
     void setColorFrom(const QColor &color);
     QColor colorTo() const;
@@ -219,6 +220,10 @@ public:
     int expansionFlags() const;
     void setExpansionFlags(int flags);
 
+    Q_INVOKABLE void selectAll();
+    Q_INVOKABLE void selectRange(int first, int last);
+    Q_INVOKABLE void clearSelection();
+
 private Q_SLOTS:
     void unbindItem();
     void completed();
@@ -236,6 +241,8 @@ Q_SIGNALS:
     void effectiveCurrentIndexChanged();
 private:
     Q_DECLARE_PRIVATE(UCViewItemsAttached)
+    Q_PRIVATE_SLOT(d_func(), void _q_notifySelectedIndices())
+    Q_PRIVATE_SLOT(d_func(), void _q_trackModel())
 };
 
 UT_NAMESPACE_END
@@ -24,6 +24,7 @@
 #include <QtQuick/private/qquickrectangle_p.h>
 
 #include <UbuntuToolkit/private/uclistitemstyle_p.h>
+#include <UbuntuToolkit/private/listitemselection_p.h>
 #include <UbuntuToolkit/private/ucstyleditembase_p_p.h>
 
 #define IMPLICIT_LISTITEM_WIDTH_GU      40
@@ -31,7 +32,9 @@
 #define DIVIDER_THICKNESS_DP            1
 #define DEFAULT_SWIPE_THRESHOLD_GU      1.5
 
+class QAbstractItemModel;
 class QQuickFlickable;
+class QQmlPropertyCache;
 
 UT_NAMESPACE_BEGIN
 
@@ -72,6 +75,7 @@ public:
     void lockContentItem(bool lock);
     void update();
     void snapOut();
+    void resetState();
     void swipeEvent(const QPointF &localPos, UCSwipeEvent::Status status);
     bool swipedOverThreshold(const QPointF &mousePos, const QPointF relativePos);
     void handleLeftButtonPress(QMouseEvent *event);
@@ -85,6 +89,7 @@ public:
     QPointer<QQuickFlickable> flickable;
     QPointer<UCViewItemsAttached> parentAttached;
     QPointer<ListItemDragHandler> dragHandler;
+    QPointer<QQuickWindow> filteredWindow;
     QBasicTimer pressAndHoldTimer;
     QPointF lastPos;
     QPointF pressedPos;
@@ -116,6 +121,7 @@ public:
     void setContentMoving(bool moved);
     void preStyleChanged() override;
     bool loadStyleItem(bool animated = true) override;
+    quint16 importVersion(QObject *object) override;
     bool dragging();
     bool dragMode();
     void setDragMode(bool draggable);
@@ -156,10 +162,14 @@ public:
     bool addSelectedItem(UCListItem *item);
     bool removeSelectedItem(UCListItem *item);
     bool isItemSelected(UCListItem *item);
+    void notifySelectedIndicesChanged();
+    void _q_notifySelectedIndices();
+    int itemCount();
     void enterDragMode();
     void leaveDragMode();
     bool isDragUpdatedConnected();
     void updateSelectedIndices(int fromIndex, int toIndex);
+    void _q_trackModel();
 
     // expansion
     void expand(int index, UCListItem *listItem, bool emitChangeSignal = true);
@@ -167,16 +177,23 @@ public:
     void collapseAll();
     void toggleExpansionFlags(bool enable);
 
-    QSet<int> selectedList;
+    ListItemSelectionRanges selectedList;
     QMap<int, QPointer<UCListItem> > expansionList;
     QList< QPointer<QQuickFlickable> > flickables;
     QPointer<UCListItem> boundItem;
+    // model of the ListView, the selection follows its row changes
+    QPointer<QAbstractItemModel> trackedModel;
     ListViewProxy *listView;
     ListItemDragArea *dragArea;
+    // import version shared by the ListItem delegates of the same type
+    QQmlPropertyCache *versionPropertyCache;
     UCViewItemsAttached::ExpansionFlags expansionFlags;
+    quint16 delegateVersion;
     bool selectable:1;
     bool draggable:1;
     bool ready:1;
+    bool selectionNotifyPending:1;
+    bool modelMovedRows:1;
 };
 
 UT_NAMESPACE_END
@@ -17,8 +17,8 @@
 #ifndef UCMOUSE_P_H
 #define UCMOUSE_P_H
 
-#include <QtCore/QBasicTimer>
 #include <QtCore/QObject>
+#include <QtCore/QVector>
 #include <QtQml/QtQml>
 #include <QtQuick/QQuickItem>
 #include <QtQuick/private/qquickevents_p_p.h>
@@ -64,6 +64,34 @@ private:
     static QEvent::Type m_eventBase;
 };
 
+class UCMouse;
+class UBUNTUTOOLKIT_EXPORT UCMouseDispatcher : public QObject
+{
+public:
+    static UCMouseDispatcher *forWindow(QQuickWindow *window, bool create = false);
+
+    void addFilter(UCMouse *filter);
+    void removeFilter(UCMouse *filter);
+
+    // dispatch cost counters
+    quint64 dispatchedEvents() const { return m_dispatchedEvents; }
+    quint64 visitedFilters() const { return m_visitedFilters; }
+    void resetCounters();
+
+protected:
+    bool eventFilter(QObject *target, QEvent *event) override;
+
+private:
+    explicit UCMouseDispatcher(QQuickWindow *window);
+    ~UCMouseDispatcher();
+
+    QQuickWindow *m_window;
+    // in priority order, the last added filter gets the events first
+    QVector<UCMouse*> m_filters;
+    quint64 m_dispatchedEvents;
+    quint64 m_visitedFilters;
+};
+
 class UBUNTUTOOLKIT_EXPORT UCMouse : public QObject
 {
     Q_OBJECT
@@ -89,6 +117,7 @@ public:
     static constexpr int DefaultPressAndHoldDelay{800};
 
     explicit UCMouse(QObject *parent = 0);
+    ~UCMouse();
 
     static UCMouse *qmlAttachedProperties(QObject *owner);
 
@@ -121,7 +150,6 @@ Q_SIGNALS:
 
 protected:
     bool eventFilter(QObject *, QEvent *) override;
-    void timerEvent(QTimerEvent *event) override;
     virtual bool mouseEvents(QObject *target, QMouseEvent *event);
     virtual bool hoverEvents(QObject *target, QHoverEvent *event);
     virtual bool forwardedEvents(ForwardedEvent *event);
@@ -141,11 +169,15 @@ protected:
     bool isMouseEvent(QEvent::Type type);
     bool isHoverEvent(QEvent::Type type);
     bool forwardEvent(ForwardedEvent::EventType type, QEvent *event, QQuickMouseEvent *quickEvent);
+    bool forwardToItem(ForwardedEvent::EventType type, QQuickItem *item, QEvent *mappedEvent,
+                       QQuickMouseEvent *forwarded, const QPointF &quickScenePos);
+    void startPressAndHold();
+    void stopPressAndHold();
+    void pressAndHoldTimeout();
 
 protected:
     QQuickItem *m_owner;
     QList<QQuickItem*> m_forwardList;
-    QBasicTimer m_pressAndHoldTimer;
     QRectF m_toleranceArea;
     QPointF m_lastPos;
     QPointF m_lastScenePos;
@@ -163,6 +195,9 @@ protected:
     bool m_hovered:1;
     bool m_doubleClicked:1;
     bool m_ignoreSynthesizedEvents:1;
+
+    friend class UCMouseDispatcher;
+    friend class PressAndHoldWheel;
 };
 
 UT_NAMESPACE_END
@@ -16,9 +16,13 @@
 
 #include "ucmouse_p.h"
 
+#include <QtCore/QBasicTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtGui/QGuiApplication>
 #include <QtQml/QQmlInfo>
 #include <QtQml/private/qqmlglobal_p.h>
+#include <QtQuick/QQuickWindow>
 #include <QtQuick/private/qquickmousearea_p.h>
 
 #include "i18n_p.h"
@@ -38,6 +42,108 @@ void ForwardedEvent::registerForwardedEvent()
     m_eventBase = (QEvent::Type)QEvent::registerEventType();
 }
 
+/*
+ * Press-and-hold timer wheel shared by all the filters. The filters are kept
+ * ordered by their deadline and a single timer is running for the closest one.
+ */
+class PressAndHoldWheel : public QObject
+{
+public:
+    static void start(UCMouse *filter, int delay);
+    static void stop(UCMouse *filter);
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    struct Entry {
+        qint64 deadline;
+        UCMouse *filter;
+    };
+
+    explicit PressAndHoldWheel(QObject *parent);
+    ~PressAndHoldWheel();
+    bool remove(UCMouse *filter);
+    void schedule();
+
+    static PressAndHoldWheel *m_instance;
+    QVector<Entry> m_entries;
+    QElapsedTimer m_clock;
+    QBasicTimer m_timer;
+};
+
+PressAndHoldWheel *PressAndHoldWheel::m_instance = Q_NULLPTR;
+
+PressAndHoldWheel::PressAndHoldWheel(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+}
+
+PressAndHoldWheel::~PressAndHoldWheel()
+{
+    m_instance = Q_NULLPTR;
+}
+
+void PressAndHoldWheel::start(UCMouse *filter, int delay)
+{
+    if (!m_instance) {
+        m_instance = new PressAndHoldWheel(QCoreApplication::instance());
+    }
+    m_instance->remove(filter);
+
+    Entry entry = {m_instance->m_clock.elapsed() + delay, filter};
+    QVector<Entry>::iterator i = m_instance->m_entries.end();
+    while (i != m_instance->m_entries.begin() && (i - 1)->deadline > entry.deadline) {
+        --i;
+    }
+    m_instance->m_entries.insert(i, entry);
+    m_instance->schedule();
+}
+
+void PressAndHoldWheel::stop(UCMouse *filter)
+{
+    if (m_instance && m_instance->remove(filter)) {
+        m_instance->schedule();
+    }
+}
+
+bool PressAndHoldWheel::remove(UCMouse *filter)
+{
+    for (int i = 0; i < m_entries.size(); i++) {
+        if (m_entries[i].filter == filter) {
+            m_entries.remove(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PressAndHoldWheel::schedule()
+{
+    if (m_entries.isEmpty()) {
+        m_timer.stop();
+    } else {
+        m_timer.start(qMax<qint64>(0, m_entries.first().deadline - m_clock.elapsed()), this);
+    }
+}
+
+void PressAndHoldWheel::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+    const qint64 now = m_clock.elapsed();
+    // the handlers may start or stop timers, so take the entries one by one
+    while (!m_entries.isEmpty() && m_entries.first().deadline <= now) {
+        UCMouse *filter = m_entries.first().filter;
+        m_entries.removeFirst();
+        filter->pressAndHoldTimeout();
+    }
+    schedule();
+}
+
 /*
  * Attached filter instantiator template
  */
@@ -398,6 +504,11 @@ UCMouse::UCMouse(QObject *parent)
     }
 }
 
+UCMouse::~UCMouse()
+{
+    PressAndHoldWheel::stop(this);
+}
+
 UCMouse *UCMouse::qmlAttachedProperties(QObject *owner)
 {
     return createAttachedFilter<UCMouse>(owner, QStringLiteral("Mouse"));
@@ -434,10 +545,20 @@ bool UCMouse::eventFilter(QObject *target, QEvent *event)
 
     return QObject::eventFilter(target, event);
 }
-void UCMouse::timerEvent(QTimerEvent *event)
+
+void UCMouse::startPressAndHold()
+{
+    PressAndHoldWheel::start(this, DefaultPressAndHoldDelay);
+}
+
+void UCMouse::stopPressAndHold()
+{
+    PressAndHoldWheel::stop(this);
+}
+
+void UCMouse::pressAndHoldTimeout()
 {
-    if (isEnabled() && (event->timerId() == m_pressAndHoldTimer.timerId())) {
-        m_pressAndHoldTimer.stop();
+    if (isEnabled()) {
         if (m_pressedButtons && m_hovered) {
             m_longPress = true;
             QQuickMouseEvent mev(m_lastPos.x(), m_lastPos.y(), m_lastButton, m_lastButtons, m_lastModifiers,
@@ -449,10 +570,7 @@ void UCMouse::timerEvent(QTimerEvent *event)
             if (!mev.isAccepted()) {
                 m_longPress = false;
             }
-            event->setAccepted(mev.isAccepted());
         }
-    } else {
-        QObject::timerEvent(event);
     }
 }
 bool UCMouse::mouseEvents(QObject *target, QMouseEvent *event)
@@ -564,7 +682,7 @@ void UCMouse::setHovered(bool hovered, QEvent *hoverEvent)
         if (m_hovered) {
             Q_EMIT entered(&mev, m_owner);
         } else {
-            m_pressAndHoldTimer.stop();
+            stopPressAndHold();
             Q_EMIT exited(&mev, m_owner);
         }
         forwardEvent(type, hoverEvent, &mev);
@@ -588,7 +706,7 @@ bool UCMouse::mousePressed(QMouseEvent *event)
         event->setAccepted(forwardEvent(ForwardedEvent::MousePress, event, &mev));
 
         // start long press timer
-        m_pressAndHoldTimer.start(DefaultPressAndHoldDelay, this);
+        startPressAndHold();
 
         return mev.isAccepted();
     }
@@ -604,7 +722,7 @@ bool UCMouse::mouseMoved(QMouseEvent *event)
 
         // check if we should stop pressAndHold
         if (!m_toleranceArea.contains(m_lastPos)) {
-            m_pressAndHoldTimer.stop();
+            stopPressAndHold();
         }
 
         setHovered(m_owner->contains(m_lastPos), Q_NULLPTR);
@@ -628,7 +746,7 @@ bool UCMouse::mouseReleased(QMouseEvent *event)
     if (m_pressedButtons) {
         saveEvent(event);
         // stop long press timer event
-        m_pressAndHoldTimer.stop();
+        stopPressAndHold();
         bool isClicked = (m_pressedButtons & m_lastButton)
                 && !m_longPress && !m_doubleClicked &&
                 ((m_moveThreshold <= 0.0) || m_toleranceArea.contains(m_lastPos));
@@ -747,7 +865,8 @@ bool UCMouse::isHoverEvent(QEvent::Type type)
 /*
  * Forwards the events to the listed items. The event coordinates are mapped to the destination's coordinates
  * and sent to the destination in case the destination has no filter attached. Otherwise the quick event
- * coordinates will be mapped and sent as ForwardedEvents.
+ * coordinates will be mapped and sent as ForwardedEvents. The scene positions are mapped and the forwarded
+ * quick event is built only once, and repositioned for each item.
  */
 bool UCMouse::forwardEvent(ForwardedEvent::EventType type, QEvent *event, QQuickMouseEvent *quickEvent)
 {
@@ -756,6 +875,26 @@ bool UCMouse::forwardEvent(ForwardedEvent::EventType type, QEvent *event, QQuick
         event->setAccepted(quickEvent->isAccepted());
     }
     bool accepted = event ? event->isAccepted() : (quickEvent ? quickEvent->isAccepted() : false);
+    if (accepted || m_forwardList.isEmpty()) {
+        return accepted;
+    }
+
+    QPointF scenePos, sceneOldPos, quickScenePos;
+    if (event && isMouseEvent(event->type())) {
+        scenePos = m_owner->mapToScene(static_cast<QMouseEvent*>(event)->pos());
+    } else if (event && isHoverEvent(event->type())) {
+        QHoverEvent *hover = static_cast<QHoverEvent*>(event);
+        scenePos = m_owner->mapToScene(hover->pos());
+        sceneOldPos = m_owner->mapToScene(hover->oldPos());
+    }
+    if (quickEvent) {
+        quickScenePos = m_owner->mapToScene(QPointF(quickEvent->x(), quickEvent->y()));
+    }
+    QQuickMouseEvent forwarded(0, 0,
+                               quickEvent ? (Qt::MouseButton)quickEvent->button() : Qt::NoButton,
+                               quickEvent ? (Qt::MouseButtons)quickEvent->buttons() : Qt::NoButton,
+                               quickEvent ? (Qt::KeyboardModifiers)quickEvent->modifiers() : Qt::NoModifier,
+                               quickEvent && quickEvent->isClick(), quickEvent && quickEvent->wasHeld());
 
     Q_FOREACH(QQuickItem *item, m_forwardList) {
 
@@ -769,38 +908,19 @@ bool UCMouse::forwardEvent(ForwardedEvent::EventType type, QEvent *event, QQuick
         }
 
         // map the normal event coordinates to item
-        QEvent *mappedEvent = 0;
-        if (event) {
-            if (isMouseEvent(event->type())) {
-                QMouseEvent *mouse = static_cast<QMouseEvent*>(event);
-                QPointF itemPos = item->mapFromScene(m_owner->mapToScene(mouse->pos()));
-                mappedEvent = new QMouseEvent(event->type(), itemPos, mouse->button(), mouse->buttons(), mouse->modifiers());
-            } else if (isHoverEvent(event->type())){
-                QHoverEvent *hover = static_cast<QHoverEvent*>(event);
-                QPointF itemPos = item->mapFromScene(m_owner->mapToScene(hover->pos()));
-                QPointF itemOldPos = item->mapFromScene(m_owner->mapToScene(hover->oldPos()));
-                mappedEvent = new QHoverEvent(event->type(), itemPos, itemOldPos, hover->modifiers());
-            }
-        }
-
-        // if the item has no filter attached, deliver the mapped event to it as it is
-        UCMouse *filter = qobject_cast<UCMouse*>(qmlAttachedPropertiesObject<UCMouse>(item, false));
-        if (!filter && mappedEvent) {
-            QGuiApplication::sendEvent(item, mappedEvent);
-            accepted = mappedEvent->isAccepted();
-        } else if (quickEvent) {
-            // map the quick event coordinates as well
-            QPoint itemPos(item->mapFromScene(m_owner->mapToScene(QPointF(quickEvent->x(), quickEvent->y()))).toPoint());
-            QQuickMouseEvent mev(itemPos.x(), itemPos.y(), (Qt::MouseButton)quickEvent->button(), (Qt::MouseButtons)quickEvent->buttons(),
-                                 (Qt::KeyboardModifiers)quickEvent->modifiers(), quickEvent->isClick(), quickEvent->wasHeld());
-            mev.setAccepted(false);
-            ForwardedEvent forwardedEvent(type, m_owner, mappedEvent, &mev);
-            QGuiApplication::sendEvent(item, &forwardedEvent);
-            accepted = mev.isAccepted();
+        if (event && isMouseEvent(event->type())) {
+            QMouseEvent *mouse = static_cast<QMouseEvent*>(event);
+            QMouseEvent mappedEvent(event->type(), item->mapFromScene(scenePos), mouse->button(), mouse->buttons(), mouse->modifiers());
+            accepted = forwardToItem(type, item, &mappedEvent, quickEvent ? &forwarded : Q_NULLPTR, quickScenePos);
+        } else if (event && isHoverEvent(event->type())) {
+            QHoverEvent *hover = static_cast<QHoverEvent*>(event);
+            QHoverEvent mappedEvent(event->type(), item->mapFromScene(scenePos), item->mapFromScene(sceneOldPos), hover->modifiers());
+            accepted = forwardToItem(type, item, &mappedEvent, quickEvent ? &forwarded : Q_NULLPTR, quickScenePos);
+        } else {
+            accepted = forwardToItem(type, item, Q_NULLPTR, quickEvent ? &forwarded : Q_NULLPTR, quickScenePos);
         }
 
-        // cleanup and transfer accepted flag
-        delete mappedEvent;
+        // transfer accepted flag
         if (event) {
             event->setAccepted(accepted);
         }
@@ -812,6 +932,28 @@ bool UCMouse::forwardEvent(ForwardedEvent::EventType type, QEvent *event, QQuick
     return accepted;
 }
 
+// delivers a forwarded event to one item, returns whether the item accepted it
+bool UCMouse::forwardToItem(ForwardedEvent::EventType type, QQuickItem *item, QEvent *mappedEvent,
+                            QQuickMouseEvent *forwarded, const QPointF &quickScenePos)
+{
+    // if the item has no filter attached, deliver the mapped event to it as it is
+    UCMouse *filter = qobject_cast<UCMouse*>(qmlAttachedPropertiesObject<UCMouse>(item, false));
+    if (!filter && mappedEvent) {
+        QGuiApplication::sendEvent(item, mappedEvent);
+        return mappedEvent->isAccepted();
+    } else if (forwarded) {
+        // map the quick event coordinates as well
+        QPoint itemPos(item->mapFromScene(quickScenePos).toPoint());
+        forwarded->setX(itemPos.x());
+        forwarded->setY(itemPos.y());
+        forwarded->setAccepted(false);
+        ForwardedEvent forwardedEvent(type, m_owner, mappedEvent, forwarded);
+        QGuiApplication::sendEvent(item, &forwardedEvent);
+        return forwarded->isAccepted();
+    }
+    return false;
+}
+
 
 /*!
    \qmlproperty bool Mouse::enabled
@@ -829,7 +971,7 @@ void UCMouse::setEnabled(bool enabled)
             m_owner->installEventFilter(this);
         } else {
             m_owner->removeEventFilter(this);
-            m_pressAndHoldTimer.stop();
+            stopPressAndHold();
         }
         Q_EMIT enabledChanged();
     }
@@ -1033,6 +1175,17 @@ void UCMouse::setPriority(Priority priority)
 UCInverseMouse::UCInverseMouse(QObject *parent)
     : UCMouse(parent)
 {
+    if (m_owner) {
+        connect(m_owner, &QQuickItem::windowChanged, this, &UCInverseMouse::updateDispatcher);
+    }
+}
+
+UCInverseMouse::~UCInverseMouse()
+{
+    UCMouseDispatcher *dispatcher = UCMouseDispatcher::forWindow(m_dispatcherWindow);
+    if (dispatcher) {
+        dispatcher->removeFilter(this);
+    }
 }
 
 UCInverseMouse *UCInverseMouse::qmlAttachedProperties(QObject *owner)
@@ -1106,17 +1259,31 @@ void UCInverseMouse::setEnabled(bool enabled)
 {
     if ((m_enabled != enabled) && m_owner) {
         m_enabled = enabled;
-        if (m_enabled) {
-            // FIXME: use application's main till we don't get touch events
-            // forwarded to the QQuickItem
-            QGuiApplication::instance()->installEventFilter(this);
-        } else {
-            QGuiApplication::instance()->removeEventFilter(this);
+        updateDispatcher();
+        if (!m_enabled) {
+            stopPressAndHold();
         }
         Q_EMIT enabledChanged();
     }
 }
 
+// register the filter to the dispatcher of the owner's window
+void UCInverseMouse::updateDispatcher()
+{
+    QQuickWindow *window = (m_enabled && m_owner) ? m_owner->window() : Q_NULLPTR;
+    if (window == m_dispatcherWindow) {
+        return;
+    }
+    UCMouseDispatcher *dispatcher = UCMouseDispatcher::forWindow(m_dispatcherWindow);
+    if (dispatcher) {
+        dispatcher->removeFilter(this);
+    }
+    m_dispatcherWindow = window;
+    if (window) {
+        UCMouseDispatcher::forWindow(window, true)->addFilter(this);
+    }
+}
+
 void UCInverseMouse::setPriority(Priority priority)
 {
     if (priority != m_priority) {
@@ -1124,4 +1291,99 @@ void UCInverseMouse::setPriority(Priority priority)
     }
 }
 
+/******************************************************************************
+ * UCMouseDispatcher
+ *
+ * Dispatches the mouse and hover events delivered within a window to the
+ * InverseMouse filters attached to the items of that window, so the filters
+ * of the other windows are not visited.
+ */
+static QHash<QQuickWindow*, UCMouseDispatcher*> mouseDispatchers;
+
+UCMouseDispatcher::UCMouseDispatcher(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+    , m_dispatchedEvents(0)
+    , m_visitedFilters(0)
+{
+    mouseDispatchers.insert(m_window, this);
+    // FIXME: use application's main till we don't get touch events
+    // forwarded to the QQuickItem
+    QGuiApplication::instance()->installEventFilter(this);
+}
+
+UCMouseDispatcher::~UCMouseDispatcher()
+{
+    mouseDispatchers.remove(m_window);
+}
+
+UCMouseDispatcher *UCMouseDispatcher::forWindow(QQuickWindow *window, bool create)
+{
+    if (!window) {
+        return Q_NULLPTR;
+    }
+    UCMouseDispatcher *dispatcher = mouseDispatchers.value(window);
+    if (!dispatcher && create) {
+        dispatcher = new UCMouseDispatcher(window);
+    }
+    return dispatcher;
+}
+
+void UCMouseDispatcher::addFilter(UCMouse *filter)
+{
+    m_filters.removeAll(filter);
+    m_filters.append(filter);
+}
+
+void UCMouseDispatcher::removeFilter(UCMouse *filter)
+{
+    m_filters.removeAll(filter);
+}
+
+void UCMouseDispatcher::resetCounters()
+{
+    m_dispatchedEvents = m_visitedFilters = 0;
+}
+
+bool UCMouseDispatcher::eventFilter(QObject *target, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::HoverEnter:
+    case QEvent::HoverMove:
+    case QEvent::HoverLeave:
+        break;
+    default:
+        return false;
+    }
+    if (m_filters.isEmpty()) {
+        return false;
+    }
+
+    QQuickItem *item = qobject_cast<QQuickItem*>(target);
+    QQuickWindow *window = item ? item->window() : qobject_cast<QQuickWindow*>(target);
+    if (window != m_window) {
+        return false;
+    }
+
+    m_dispatchedEvents++;
+    // filters may get removed while handling the event, the copy is not
+    // detached unless that happens
+    const QVector<UCMouse*> filters = m_filters;
+    for (int i = filters.size() - 1; i >= 0; i--) {
+        UCMouse *filter = filters[i];
+        if (filters.constData() != m_filters.constData() && !m_filters.contains(filter)) {
+            continue;
+        }
+        m_visitedFilters++;
+        if (filter->eventFilter(target, event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 UT_NAMESPACE_END
@@ -18,7 +18,11 @@
 
 #include "ucperformancemonitor_p.h"
 
+#include <QtCore/QRunnable>
 #include <QtGui/QGuiApplication>
+#include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <UbuntuMetrics/applicationmonitor.h>
 
 Q_LOGGING_CATEGORY(ucPerformance, "[PERFORMANCE]")
 
@@ -42,14 +46,45 @@ static int getenvInt(const char* name, int defaultValue)
     }
 }
 
+// Whether jank events are logged by the application monitor. The monitor is
+// not instantiated here, applications and the Metrics plugin do that.
+static bool jankLogging()
+{
+    UMApplicationMonitor* applicationMonitor = UMApplicationMonitor::existingInstance();
+    return applicationMonitor && applicationMonitor->logging()
+        && (applicationMonitor->loggingFilter() & UMApplicationMonitor::JankEvent);
+}
+
+QAtomicInt UCPerformanceMonitor::m_warningCount(0);
+
+// Stops a window monitor from the render thread, where none of its slots can be
+// running meanwhile, then deletes it on the GUI thread. The render loop deletes
+// the job without running it when not rendering, so this is done on deletion.
+class UCPerformanceWindowMonitorDeleter : public QRunnable
+{
+public:
+    explicit UCPerformanceWindowMonitorDeleter(UCPerformanceWindowMonitor* monitor)
+        : m_monitor(monitor)
+    {
+    }
+    ~UCPerformanceWindowMonitorDeleter()
+    {
+        m_monitor->stopMonitoring();
+        m_monitor->deleteLater();
+    }
+    void run() Q_DECL_OVERRIDE {}
+
+private:
+    UCPerformanceWindowMonitor* m_monitor;
+};
+
 UCPerformanceMonitor::UCPerformanceMonitor(QObject* parent) :
-    QObject(parent),
-    m_framesAboveThreshold(0),
-    m_warningCount(0),
-    m_window(NULL)
+    QObject(parent)
 {
     QObject::connect((QGuiApplication*)QGuiApplication::instance(), &QGuiApplication::applicationStateChanged,
                      this, &UCPerformanceMonitor::onApplicationStateChanged);
+    QObject::connect((QGuiApplication*)QGuiApplication::instance(), &QGuiApplication::focusWindowChanged,
+                     this, &UCPerformanceMonitor::onFocusWindowChanged);
 
     singleFrameThreshold = getenvInt("UC_PERFORMANCE_MONITOR_SINGLE_FRAME_THRESHOLD", singleFrameThreshold);
     multipleFrameThreshold = getenvInt("UC_PERFORMANCE_MONITOR_MULTIPLE_FRAME_THRESHOLD", multipleFrameThreshold);
@@ -59,101 +94,240 @@ UCPerformanceMonitor::UCPerformanceMonitor(QObject* parent) :
 
 UCPerformanceMonitor::~UCPerformanceMonitor()
 {
+    disconnectFromWindows();
 }
 
-QQuickWindow* UCPerformanceMonitor::findQQuickWindow()
+// monitor as long as there are warnings to give or jank events to log
+bool UCPerformanceMonitor::monitoring()
 {
-    Q_FOREACH (QWindow *w, QGuiApplication::topLevelWindows()) {
-        QQuickWindow* rootWindow = qobject_cast<QQuickWindow*>(w);
-        if (rootWindow) {
-            return rootWindow;
-        }
-    }
-    return NULL;
+    return (m_warningCount.load() < warningCountThreshold || warningCountThreshold == -1)
+        || jankLogging();
 }
 
 void UCPerformanceMonitor::onApplicationStateChanged(Qt::ApplicationState state)
 {
-    if (m_warningCount >= warningCountThreshold && warningCountThreshold != -1) {
-        // do not monitor performance if the warning count threshold was reached
-        return;
+    if (state == Qt::ApplicationActive && monitoring()) {
+        Q_FOREACH (QWindow *w, QGuiApplication::topLevelWindows()) {
+            connectToWindow(qobject_cast<QQuickWindow*>(w));
+        }
+    } else {
+        disconnectFromWindows();
     }
+}
 
-    if (state == Qt::ApplicationActive) {
-        connectToWindow(findQQuickWindow());
-    } else {
-        connectToWindow(NULL);
+// catch the windows shown after the application got active
+void UCPerformanceMonitor::onFocusWindowChanged(QWindow* window)
+{
+    if (QGuiApplication::applicationState() == Qt::ApplicationActive && monitoring()) {
+        connectToWindow(qobject_cast<QQuickWindow*>(window));
     }
 }
 
 void UCPerformanceMonitor::connectToWindow(QQuickWindow* window)
 {
-    if (window != m_window) {
-        if (m_window != NULL) {
-            QObject::disconnect(m_window, &QQuickWindow::beforeSynchronizing,
-                                this, &UCPerformanceMonitor::startTimer);
-            QObject::disconnect(m_window, &QQuickWindow::afterRendering,
-                                this, &UCPerformanceMonitor::stopTimer);
-            QObject::disconnect(m_window, &QWindow::destroyed,
-                                this, &UCPerformanceMonitor::windowDestroyed);
-        }
+    if (!window || m_windows.contains(window)) {
+        return;
+    }
+    m_windows.insert(window, new UCPerformanceWindowMonitor(window));
+    QObject::connect(window, &QObject::destroyed,
+                     this, &UCPerformanceMonitor::windowDestroyed);
+}
 
-        m_window = window;
-
-        if (m_window != NULL) {
-            QObject::connect(m_window, &QQuickWindow::beforeSynchronizing,
-                             this, &UCPerformanceMonitor::startTimer,
-                             Qt::DirectConnection);
-            QObject::connect(m_window, &QQuickWindow::afterRendering,
-                             this, &UCPerformanceMonitor::stopTimer,
-                             Qt::DirectConnection);
-            QObject::connect(m_window, &QWindow::destroyed,
-                             this, &UCPerformanceMonitor::windowDestroyed);
-        }
+void UCPerformanceMonitor::disconnectFromWindows()
+{
+    QHash<QQuickWindow*, UCPerformanceWindowMonitor*>::const_iterator i;
+    for (i = m_windows.constBegin(); i != m_windows.constEnd(); ++i) {
+        QObject::disconnect(i.key(), &QObject::destroyed,
+                            this, &UCPerformanceMonitor::windowDestroyed);
+        // the monitor's slots are called from the render thread
+        i.key()->scheduleRenderJob(new UCPerformanceWindowMonitorDeleter(i.value()),
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+            QQuickWindow::NoStage);
+#else
+            QQuickWindow::BeforeSynchronizingStage);
+        i.key()->update();  // Wake up the render loop.
+#endif
     }
+    m_windows.clear();
 }
 
-void UCPerformanceMonitor::startTimer()
+// the window stopped rendering by the time it is destroyed
+void UCPerformanceMonitor::windowDestroyed(QObject* window)
 {
-    m_timer.start();
+    delete m_windows.take(static_cast<QQuickWindow*>(window));
 }
 
-void UCPerformanceMonitor::stopTimer()
+// called from the render thread of the window once the frame is rendered
+void UCPerformanceMonitor::frameRendered(UCPerformanceWindowMonitor* monitor, int totalTimeInMs)
 {
-    if (!m_timer.isValid()) {
+    if (m_warningCount.load() >= warningCountThreshold && warningCountThreshold != -1) {
         return;
     }
 
-    const int totalTimeInMs = m_timer.elapsed();
-    m_timer.invalidate();
-
     if (totalTimeInMs >= singleFrameThreshold) {
         qCWarning(ucPerformance, "Last frame took %d ms to render.", totalTimeInMs);
-        m_warningCount++;
+        m_warningCount.ref();
     }
 
     if (totalTimeInMs >= multipleFrameThreshold) {
-        m_framesAboveThreshold++;
-        if (m_framesAboveThreshold >= framesCountThreshold) {
+        monitor->framesAboveThreshold++;
+        if (monitor->framesAboveThreshold >= framesCountThreshold) {
             qCWarning(ucPerformance,
                       "Last %d frames took over %d ms to render (last frame: %d ms)",
-                      m_framesAboveThreshold, multipleFrameThreshold, totalTimeInMs);
-            m_framesAboveThreshold = 0;
-            m_warningCount++;
+                      monitor->framesAboveThreshold, multipleFrameThreshold, totalTimeInMs);
+            monitor->framesAboveThreshold = 0;
+            m_warningCount.ref();
         }
     } else {
-        m_framesAboveThreshold = 0;
+        monitor->framesAboveThreshold = 0;
+    }
+
+    if (m_warningCount.load() >= warningCountThreshold && warningCountThreshold != -1) {
+        qCWarning(ucPerformance, "Too many warnings were given. Performance warnings stop.");
+    }
+}
+
+/******************************************************************************
+ * UCPerformanceWindowMonitor
+ */
+UCPerformanceWindowMonitor::UCPerformanceWindowMonitor(QQuickWindow* window)
+    : QObject()
+    , framesAboveThreshold(0)
+    , m_window(window)
+    , m_syncTime(0)
+{
+    QObject::connect(m_window, &QQuickWindow::beforeSynchronizing,
+                     this, &UCPerformanceWindowMonitor::beforeSynchronizing,
+                     Qt::DirectConnection);
+    QObject::connect(m_window, &QQuickWindow::afterSynchronizing,
+                     this, &UCPerformanceWindowMonitor::afterSynchronizing,
+                     Qt::DirectConnection);
+    QObject::connect(m_window, &QQuickWindow::afterRendering,
+                     this, &UCPerformanceWindowMonitor::afterRendering,
+                     Qt::DirectConnection);
+    m_window->installEventFilter(this);
+}
+
+UCPerformanceWindowMonitor::~UCPerformanceWindowMonitor()
+{
+    if (m_window) {
+        m_window->removeEventFilter(this);
+    }
+}
+
+// disconnects from the window's render signals
+void UCPerformanceWindowMonitor::stopMonitoring()
+{
+    if (m_window) {
+        QObject::disconnect(m_window, 0, this, 0);
+    }
+}
+
+void UCPerformanceWindowMonitor::ItemTypes::add(QQuickItem* item)
+{
+    itemCount++;
+    const char* type = item->metaObject()->className();
+    for (int i = 0; i < typeCount; i++) {
+        if (types[i] == type || !qstrcmp(types[i], type)) {
+            return;
+        }
+    }
+    if (typeCount < maxTypes) {
+        types[typeCount++] = type;
+    }
+}
+
+// prints the comma separated type names, returns the length printed without
+// the null-terminating char
+int UCPerformanceWindowMonitor::ItemTypes::print(char* buffer, int size, bool separate) const
+{
+    int length = 0;
+    for (int i = 0; i < typeCount && length < size - 1; i++) {
+        if (separate || i > 0) {
+            buffer[length++] = ',';
+        }
+        // QML types are named after their document or base type
+        const char* type = types[i];
+        const char* suffix = strstr(type, "_QML");
+        const int typeLength = suffix ? int(suffix - type) : qstrlen(type);
+        const int copied = qMin(typeLength, size - 1 - length);
+        memcpy(buffer + length, type, copied);
+        length += copied;
     }
+    buffer[length] = '\0';
+    return length;
+}
 
-    if (m_warningCount >= warningCountThreshold && warningCountThreshold != -1) {
-        qCWarning(ucPerformance, "Too many warnings were given. Performance monitoring stops.");
-        connectToWindow(NULL);
+bool UCPerformanceWindowMonitor::eventFilter(QObject* object, QEvent* event)
+{
+    // the items to polish are gone by the time the render loop synchronizes
+    if (event->type() == QEvent::UpdateRequest && object == m_window && jankLogging()) {
+        m_pendingPolished.clear();
+        Q_FOREACH (QQuickItem* item, QQuickWindowPrivate::get(m_window)->itemsToPolish) {
+            m_pendingPolished.add(item);
+        }
     }
+    return QObject::eventFilter(object, event);
 }
 
-void UCPerformanceMonitor::windowDestroyed()
+// the GUI thread is blocked during synchronization, the window's state can be read
+void UCPerformanceWindowMonitor::beforeSynchronizing()
 {
-    connectToWindow(NULL);
+    m_timer.start();
+    m_polished = m_pendingPolished;
+    m_pendingPolished.clear();
+    m_updated.clear();
+    if (!jankLogging()) {
+        return;
+    }
+    QQuickItem* item = QQuickWindowPrivate::get(m_window)->dirtyItemList;
+    while (item) {
+        QQuickItemPrivate* itemPrivate = QQuickItemPrivate::get(item);
+        if ((itemPrivate->dirtyAttributes & QQuickItemPrivate::ContentUpdateMask)
+                && (itemPrivate->flags & QQuickItem::ItemHasContents)) {
+            m_updated.add(item);
+        }
+        item = itemPrivate->nextDirtyItem;
+    }
+}
+
+void UCPerformanceWindowMonitor::afterSynchronizing()
+{
+    m_syncTime = m_timer.nsecsElapsed();
+}
+
+void UCPerformanceWindowMonitor::afterRendering()
+{
+    if (!m_timer.isValid()) {
+        return;
+    }
+
+    const qint64 totalTime = m_timer.nsecsElapsed();
+    m_timer.invalidate();
+    const int totalTimeInMs = totalTime / 1000000;
+
+    if (totalTimeInMs >= multipleFrameThreshold) {
+        logJankEvent(m_syncTime, totalTime - m_syncTime);
+    }
+    UCPerformanceMonitor::frameRendered(this, totalTimeInMs);
+}
+
+bool UCPerformanceWindowMonitor::logJankEvent(qint64 syncTime, qint64 renderTime)
+{
+    UMApplicationMonitor* applicationMonitor = UMApplicationMonitor::existingInstance();
+    if (!applicationMonitor) {
+        return false;
+    }
+    UMJankEvent jank;
+    memset(&jank, 0, sizeof(jank));
+    jank.syncTime = syncTime;
+    jank.renderTime = renderTime;
+    jank.polishedItemCount = qMin(m_polished.itemCount, 0xffff);
+    jank.updatedItemCount = qMin(m_updated.itemCount, 0xffff);
+    int length = m_polished.print(jank.items, UMJankEvent::maxItemsSize, false);
+    length += m_updated.print(jank.items + length, UMJankEvent::maxItemsSize - length, length > 0);
+    jank.itemsSize = length + 1;
+    return applicationMonitor->logJankEvent(m_window, jank);
 }
 
 UT_NAMESPACE_END
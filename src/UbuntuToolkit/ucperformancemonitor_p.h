@@ -19,16 +19,22 @@
 #ifndef UCPERFORMANCEMONITOR_P_H
 #define UCPERFORMANCEMONITOR_P_H
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
 #include <QtQuick/QQuickWindow>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
+class QQuickItem;
+
 UT_NAMESPACE_BEGIN
 
+class UCPerformanceWindowMonitor;
 class UBUNTUTOOLKIT_EXPORT UCPerformanceMonitor : public QObject
 {
     Q_OBJECT
@@ -39,19 +45,67 @@ public:
 
 private Q_SLOTS:
     void onApplicationStateChanged(Qt::ApplicationState state);
+    void onFocusWindowChanged(QWindow* window);
     void connectToWindow(QQuickWindow* window);
-    void startTimer();
-    void stopTimer();
-    void windowDestroyed();
+    void windowDestroyed(QObject* window);
 
 private:
-    QQuickWindow* findQQuickWindow();
+    void disconnectFromWindows();
+    static bool monitoring();
+    static void frameRendered(UCPerformanceWindowMonitor* monitor, int totalTimeInMs);
 
 private:
-    int m_framesAboveThreshold;
-    int m_warningCount;
+    // shared with the window monitors outliving the performance monitor
+    static QAtomicInt m_warningCount;
+    QHash<QQuickWindow*, UCPerformanceWindowMonitor*> m_windows;
+
+    friend class UCPerformanceWindowMonitor;
+};
+
+// Times the frames of a window from the render thread and collects the items
+// involved in the frames.
+class UCPerformanceWindowMonitor : public QObject
+{
+public:
+    explicit UCPerformanceWindowMonitor(QQuickWindow* window);
+    ~UCPerformanceWindowMonitor();
+
+    void stopMonitoring();
+
+    // Distinct types of the items involved in a frame.
+    struct ItemTypes {
+        static const int maxTypes = 8;
+        int itemCount;
+        int typeCount;
+        const char* types[maxTypes];
+
+        ItemTypes() : itemCount(0), typeCount(0) {}
+        void clear() { itemCount = typeCount = 0; }
+        void add(QQuickItem* item);
+        int print(char* buffer, int size, bool separate) const;
+    };
+
+    QQuickWindow* window() const { return m_window.data(); }
+    bool logJankEvent(qint64 syncTime, qint64 renderTime);
+
+    int framesAboveThreshold;
+
+protected:
+    bool eventFilter(QObject* object, QEvent* event) Q_DECL_OVERRIDE;
+
+private:
+    void beforeSynchronizing();
+    void afterSynchronizing();
+    void afterRendering();
+
+    QPointer<QQuickWindow> m_window;
     QElapsedTimer m_timer;
-    QQuickWindow* m_window;
+    qint64 m_syncTime;
+    // items queued for polishing when the frame was requested, GUI thread only
+    ItemTypes m_pendingPolished;
+    // items of the frame being rendered, render thread only
+    ItemTypes m_polished;
+    ItemTypes m_updated;
 };
 
 UT_NAMESPACE_END
@@ -34,9 +34,10 @@ UCSlotsLayoutPrivate::UCSlotsLayoutPrivate()
     , m_parentItem(Q_NULLPTR)
     , mainSlotHeight(0)
     , maxSlotsHeight(0)
-    , _q_cachedHeight(-1)
     , maxNumberOfLeadingSlots(1)
     , maxNumberOfTrailingSlots(2)
+    , progression(false)
+    , layoutDirty(false)
 {
 }
 
@@ -59,13 +60,11 @@ void UCSlotsLayoutPrivate::init()
 
     QObject::connect(UCUnits::instance(), SIGNAL(gridUnitChanged()), q, SLOT(_q_onGuValueChanged()));
 
-    //FIXME (if possible): this will cause relayout to be called 4-5 times when the layout has "anchors.fill: parent"
-    //defined on QML side
+    //these only schedule a relayout, so they're cheap even when the layout has
+    //"anchors.fill: parent" and the geometry changes several times in a row
     QObject::connect(q, SIGNAL(widthChanged()), q, SLOT(_q_relayout()));
-
-    //we connect height changes to a different function, because height changes only cause a relayout
-    //in some cases (for instance when height goes from 0 to non 0)
-    QObject::connect(q, SIGNAL(heightChanged()), q, SLOT(_q_updateCachedHeight()));
+    //slots are vertically positioned relative to the height of the layout
+    QObject::connect(q, SIGNAL(heightChanged()), q, SLOT(_q_relayout()));
 
     QObject::connect(q, SIGNAL(visibleChanged()), q, SLOT(_q_relayout()));
 }
@@ -122,12 +121,8 @@ void UCSlotsLayoutPrivate::insertSlotIntoSortedList(QQuickItem *slot,
     int i = 0;
     const int size = slotsList.length();
     for (i = 0; i < size; ++i) {
-        UCSlotsAttached *attachedProperty =
-                qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(slotsList.at(i)));
-
+        UCSlotsAttached *attachedProperty = slotAttached(slotsList.at(i));
         if (!attachedProperty) {
-            Q_Q(UCSlotsLayout);
-            qmlInfo(q) << "Invalid attached property!";
             return;
         }
 
@@ -145,11 +140,8 @@ void UCSlotsLayoutPrivate::addSlot(QQuickItem *slot)
         qFatal("addSlot: INVALID POINTER!");
     }
 
-    Q_Q(UCSlotsLayout);
-    UCSlotsAttached *attachedProperty =
-            qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(slot));
+    UCSlotsAttached *attachedProperty = slotAttached(slot);
     if (!attachedProperty) {
-        qmlInfo(q) << "Invalid attached property!";
         return;
     }
 
@@ -166,11 +158,8 @@ void UCSlotsLayoutPrivate::removeSlot(QQuickItem *slot)
         qFatal("addSlot: INVALID POINTER!");
     }
 
-    Q_Q(UCSlotsLayout);
-    UCSlotsAttached *attachedProperty =
-            qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(slot));
+    UCSlotsAttached *attachedProperty = slotAttached(slot);
     if (!attachedProperty) {
-        qmlInfo(q) << "Invalid attached property!";
         return;
     }
 
@@ -181,6 +170,26 @@ void UCSlotsLayoutPrivate::removeSlot(QQuickItem *slot)
     }
 }
 
+UCSlotsAttached *UCSlotsLayoutPrivate::slotAttached(QQuickItem *slot)
+{
+    UCSlotsAttached *attached = attachedSlots.value(slot);
+    if (!attached) {
+        attached = qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(slot));
+        if (!attached) {
+            Q_Q(UCSlotsLayout);
+            qmlInfo(q) << "Invalid attached property!";
+            return Q_NULLPTR;
+        }
+        attachedSlots.insert(slot, attached);
+    }
+    return attached;
+}
+
+void UCSlotsLayoutPrivate::mirrorChange()
+{
+    _q_relayout();
+}
+
 void UCSlotsLayoutPrivate::_q_onGuValueChanged()
 {
     _q_updateCachedMainSlotHeight();
@@ -188,17 +197,6 @@ void UCSlotsLayoutPrivate::_q_onGuValueChanged()
     _q_updateGuValues();
 }
 
-void UCSlotsLayoutPrivate::_q_updateCachedHeight()
-{
-    Q_Q(UCSlotsLayout);
-    if (_q_cachedHeight != q->height()) {
-        if (qIsNull(_q_cachedHeight)) {
-            _q_relayout();
-        }
-        _q_cachedHeight = q->height();
-    }
-}
-
 void UCSlotsLayoutPrivate::_q_updateGuValues()
 {
     if (!padding.leadingWasSetFromQml) {
@@ -221,14 +219,9 @@ void UCSlotsLayoutPrivate::_q_updateCachedMainSlotHeight()
     if (!componentComplete)
         return;
 
-    Q_Q(UCSlotsLayout);
-
     if (mainSlot) {
-        UCSlotsAttached *attachedProperty =
-                qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(mainSlot));
-
+        UCSlotsAttached *attachedProperty = slotAttached(mainSlot);
         if (!attachedProperty) {
-            qmlInfo(q) << "Invalid attached property!";
             mainSlotHeight = 0;
             return;
         }
@@ -247,8 +240,6 @@ void UCSlotsLayoutPrivate::_q_updateSlotsBBoxHeight()
     if (!componentComplete)
         return;
 
-    Q_Q(UCSlotsLayout);
-
     qreal maxSlotsHeightTmp = 0;
     const int numOfLeading = leadingSlots.count();
     const int numOfTrailing = trailingSlots.count();
@@ -277,11 +268,8 @@ void UCSlotsLayoutPrivate::_q_updateSlotsBBoxHeight()
             }
         }
         if (!skipSlotFlag) {
-            UCSlotsAttached *attachedProperty =
-                    qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(child));
-
+            UCSlotsAttached *attachedProperty = slotAttached(child);
             if (!attachedProperty) {
-                qmlInfo(q) << "Invalid attached property!";
                 continue;
             }
 
@@ -390,88 +378,68 @@ void UCSlotsLayoutPrivate::setupSlotsVerticalPositioning(QQuickItem *slot, UCSlo
     if (slot == Q_NULLPTR)
         return;
 
-    UCSlotsAttached* attachedProps = attached;
-    if (attached == Q_NULLPTR) {
-        attachedProps = qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(slot));
-
-        if (attachedProps == Q_NULLPTR) {
-            Q_Q(UCSlotsLayout);
-            qmlInfo(q) << "Invalid attached property!";
-            return;
-        }
-    }
+    UCSlotsAttached* attachedProps = attached ? attached : slotAttached(slot);
+    if (attachedProps == Q_NULLPTR)
+        return;
 
-    QQuickAnchors *slotAnchors = QQuickItemPrivate::get(slot)->anchors();
     if (getVerticalPositioningMode() == UCSlotPositioningMode::AlignToTop) {
-        //reset the vertical anchor as we might be transitioning from the configuration
-        //where all items are vertically centered to the one where they're anchored to top
-        slotAnchors->resetVerticalCenter();
-        slotAnchors->setVerticalCenterOffset(0);
-
-        slotAnchors->setTop(top());
-        slotAnchors->setTopMargin(padding.top() + attachedProps->padding()->top());
+        slot->setY(padding.top() + attachedProps->padding()->top());
     } else {
-        slotAnchors->resetTop();
-
-        slotAnchors->setVerticalCenter(verticalCenter());
+        Q_Q(UCSlotsLayout);
         //bottom and top offsets could have different values
         qreal offset = (padding.top() - padding.bottom()
                         + attachedProps->padding()->top()
                         - attachedProps->padding()->bottom()) / 2.0;
-        slotAnchors->setVerticalCenterOffset(offset);
+        //align the centered position to a whole pixel, as centering anchors do
+        slot->setY(qRound((q->height() - slot->height()) / 2.0) + offset);
     }
 }
 
-void UCSlotsLayoutPrivate::layoutInRow(qreal siblingAnchorMargin, QQuickAnchorLine siblingAnchor, QList<QQuickItem *> &items)
+void UCSlotsLayoutPrivate::layoutInRow(qreal leadingMargin, QList<QQuickItem *> &items)
 {
     Q_Q(UCSlotsLayout);
 
+    const qreal layoutWidth = q->width();
+    qreal leadingEdge = leadingMargin;
     const int size = items.length();
     for (int i = 0; i < size; i++) {
         QQuickItem *item = items.at(i);
-        QQuickAnchors *itemAnchors = QQuickItemPrivate::get(item)->anchors();
-
-        UCSlotsAttached *attached =
-                qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(item));
-
+        UCSlotsAttached *attached = slotAttached(item);
         if (!attached) {
-            qmlInfo(q) << "Invalid attached property!";
             continue;
         }
 
-        if (!attached->overrideVerticalPositioning()) {
+        //mainSlot ignores the value of its overrideVerticalPositioning
+        if (item == mainSlot || !attached->overrideVerticalPositioning()) {
             setupSlotsVerticalPositioning(item, attached);
         }
 
-        if (i == 0) {
-            //skip anchoring if the anchor given as input is invalid
-            if (siblingAnchor.item == Q_NULLPTR)
-                continue;
-
-            itemAnchors->setLeft(siblingAnchor);
-            itemAnchors->setLeftMargin(attached->padding()->leading() + siblingAnchorMargin);
-        } else {
-            UCSlotsAttached *attachedPreviousItem =
-                    qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(items.at(i - 1)));
-
-            if (!attachedPreviousItem) {
-                qmlInfo(q) << "Invalid attached property!";
-            } else {
-                itemAnchors->setLeft(QQuickItemPrivate::get(items.at(i - 1))->right());
-                itemAnchors->setLeftMargin(attachedPreviousItem->padding()->trailing() + attached->padding()->leading());
-            }
-        }
+        leadingEdge += attached->padding()->leading();
+        //follow the slot's mirroring, the same way its horizontal anchors would
+        item->setX(QQuickItemPrivate::get(item)->effectiveLayoutMirror
+                   ? layoutWidth - leadingEdge - item->width()
+                   : leadingEdge);
+        leadingEdge += item->width() + attached->padding()->trailing();
     }
 }
 
 void UCSlotsLayoutPrivate::_q_relayout()
 {
-    Q_Q(UCSlotsLayout);
-
     //only relayout after the component has been initialized
     if (!componentComplete)
         return;
 
+    //the layout itself is done once per frame, in updatePolish()
+    Q_Q(UCSlotsLayout);
+    layoutDirty = true;
+    q->polish();
+}
+
+void UCSlotsLayoutPrivate::relayout()
+{
+    Q_Q(UCSlotsLayout);
+    layoutDirty = false;
+
     if (q->width() <= 0 || q->height() <= 0
             || !q->isVisible() || !q->opacity()) {
         return;
@@ -489,6 +457,7 @@ void UCSlotsLayoutPrivate::_q_relayout()
     const int numOfTrailing = trailingSlots.count();
     int numOfLeadingToLayout = 0;
     int numOfTrailingToLayout = 0;
+    itemsToLayout.reserve(numOfLeading + numOfTrailing + 1);
     //instead of having 2 cycles we only make one which iterates over both lists
     for (int i = 0; i < numOfLeading + numOfTrailing; i++) {
         QQuickItem *child = i < numOfLeading
@@ -517,30 +486,25 @@ void UCSlotsLayoutPrivate::_q_relayout()
             }
         }
         if (!skipSlotFlag) {
-            itemsToLayout.append(child);
-            UCSlotsAttached *attached =
-                    qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(child));
-
+            UCSlotsAttached *attached = slotAttached(child);
             if (!attached) {
-                qmlInfo(q) << "Invalid attached property!";
                 continue;
             }
+            itemsToLayout.append(child);
             totalSlotsWidth += child->width() + attached->padding()->leading()
                     + attached->padding()->trailing();
         }
     }
 
     if (mainSlot) {
-        //insert between leading and trailing
-        itemsToLayout.insert(numOfLeadingToLayout, mainSlot);
-
-        UCSlotsAttached *attachedProps =
-                qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(mainSlot));
-
+        UCSlotsAttached *attachedProps = slotAttached(mainSlot);
         if (!attachedProps) {
-            qmlInfo(q) << "Invalid attached property!";
             return;
         }
+
+        //insert between leading and trailing
+        itemsToLayout.insert(numOfLeadingToLayout, mainSlot);
+
         //bug#1630167: set width instead of implicitWidth to avoid clashing with internal logic of the
         //component which is inside the mainSlot (e.g. Column and positioners handle the implicit width
         //themselves)
@@ -550,7 +514,7 @@ void UCSlotsLayoutPrivate::_q_relayout()
                                    - padding.leading() - padding.trailing());
     }
 
-    layoutInRow(padding.leading(), left(), itemsToLayout);
+    layoutInRow(padding.leading(), itemsToLayout);
 }
 
 void UCSlotsLayoutPrivate::handleAttachedPropertySignals(QQuickItem *item, bool connect)
@@ -561,10 +525,8 @@ void UCSlotsLayoutPrivate::handleAttachedPropertySignals(QQuickItem *item, bool
     }
 
     Q_Q(UCSlotsLayout);
-    UCSlotsAttached *attachedSlot =
-            qobject_cast<UCSlotsAttached *>(qmlAttachedPropertiesObject<UCSlotsLayout>(item));
+    UCSlotsAttached *attachedSlot = slotAttached(item);
     if (!attachedSlot) {
-        qmlInfo(q) << "Invalid attached property!";
         return;
     }
 
@@ -590,7 +552,7 @@ void UCSlotsLayoutPrivate::handleAttachedPropertySignals(QQuickItem *item, bool
             QObject::disconnect(attachedSlot, SIGNAL(positionChanged()), q, SLOT(_q_onSlotPositionChanged()));
             QObject::disconnect(attachedSlot->padding(), SIGNAL(topChanged()), q, SLOT(_q_updateSlotsBBoxHeight()));
             QObject::disconnect(attachedSlot->padding(), SIGNAL(bottomChanged()), q, SLOT(_q_updateSlotsBBoxHeight()));
-            QObject::disconnect(attachedSlot, SIGNAL(overrideVerticalPositioningChanged()), q, SLOT(_q_updateSlotsBBoxHeight()));
+            QObject::disconnect(attachedSlot, SIGNAL(overrideVerticalPositioningChanged()), q, SLOT(_q_onSlotOverrideVerticalPositioningChanged()));
         } else {
             QObject::disconnect(attachedSlot->padding(), SIGNAL(topChanged()), q, SLOT(_q_updateCachedMainSlotHeight()));
             QObject::disconnect(attachedSlot->padding(), SIGNAL(bottomChanged()), q, SLOT(_q_updateCachedMainSlotHeight()));
@@ -898,6 +860,10 @@ void UCSlotsLayout::componentComplete()
 
     d->_q_updateCachedMainSlotHeight();
     d->_q_updateSlotsBBoxHeight();
+
+    //lay the slots out right away so that the first frame (and views sizing
+    //their delegates) already see the final geometry
+    d->relayout();
 }
 
 void UCSlotsLayout::itemChange(ItemChange change, const ItemChangeData &data)
@@ -934,7 +900,7 @@ void UCSlotsLayout::itemChange(ItemChange change, const ItemChangeData &data)
 
             //This wouldn't be needed if the child is destroyed, but we can't know what, we just know
             //that it's changing parent, so we still disconnect from all the signals manually
-            QObject::disconnect(data.item, SIGNAL(visibleChanged()), this, SLOT(_q_relayout()));
+            QObject::disconnect(data.item, SIGNAL(visibleChanged()), this, SLOT(_q_updateSlotsBBoxHeight()));
 
             if (data.item != d->mainSlot) {
                 d->removeSlot(data.item);
@@ -945,6 +911,7 @@ void UCSlotsLayout::itemChange(ItemChange change, const ItemChangeData &data)
                 QObject::disconnect(data.item, SIGNAL(heightChanged()), this, SLOT(_q_updateCachedMainSlotHeight()));
                 d->_q_updateCachedMainSlotHeight();
             }
+            d->attachedSlots.remove(data.item);
         }
 
         break;
@@ -967,6 +934,14 @@ void UCSlotsLayout::itemChange(ItemChange change, const ItemChangeData &data)
     QQuickItem::itemChange(change, data);
 }
 
+void UCSlotsLayout::updatePolish()
+{
+    Q_D(UCSlotsLayout);
+    if (d->layoutDirty) {
+        d->relayout();
+    }
+}
+
 /*!
    \qmlproperty Item SlotsLayout::mainSlot
    This property represents the main slot of the layout. By default, SlotsLayout has
@@ -66,10 +66,10 @@ protected:
     Q_DECLARE_PRIVATE(UCSlotsLayout)
     void componentComplete() override;
     void itemChange(ItemChange change, const ItemChangeData &data) override;
+    void updatePolish() override;
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_onGuValueChanged())
-    Q_PRIVATE_SLOT(d_func(), void _q_updateCachedHeight())
     Q_PRIVATE_SLOT(d_func(), void _q_updateGuValues())
     Q_PRIVATE_SLOT(d_func(), void _q_updateCachedMainSlotHeight())
     Q_PRIVATE_SLOT(d_func(), void _q_updateSlotsBBoxHeight())
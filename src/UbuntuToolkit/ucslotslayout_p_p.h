@@ -21,6 +21,7 @@
 
 #include <UbuntuToolkit/private/ucslotslayout_p.h>
 
+#include <QtCore/QHash>
 #include <QtQuick/private/qquickitem_p.h>
 
 #define IMPLICIT_SLOTSLAYOUT_WIDTH_GU                40
@@ -61,15 +62,21 @@ public:
     void addSlot(QQuickItem *slot);
     void removeSlot(QQuickItem *slot);
 
-    //layout "items" in a row, optionally anchoring the row to a sibling with margin siblingAnchorMargin
-    //The optional anchoring behaviour can be disable by passing QQuickAnchorLine()
-    void layoutInRow(qreal siblingAnchorMargin, QQuickAnchorLine siblingAnchor, QList<QQuickItem *> &items);
+    //returns the attached properties of "slot", querying the qml engine only
+    //the first time the slot is seen
+    UCSlotsAttached *slotAttached(QQuickItem *slot);
 
-    //this method sets up vertical anchors and paddings for a slot ("item").
+    //position "items" in a row, starting at leadingMargin from the leading edge of the layout
+    void layoutInRow(qreal leadingMargin, QList<QQuickItem *> &items);
+
+    //this method sets the vertical position of a slot ("item") taking paddings into account.
     //Attached properties are taken from "attached", if not null, otherwise
-    //qml engine is queried.
+    //they are looked up using slotAttached().
     void setupSlotsVerticalPositioning(QQuickItem *item, UCSlotsAttached* attached = Q_NULLPTR);
 
+    //does the actual layout, called from updatePolish() or when the component completes
+    void relayout();
+
     //We have two vertical positioning modes according to the visual design rules:
     //- RETURN VALUE CenterVertically --> All items have to be vertically centered
     //- RETURN VALUE AlignToTop --> All items have to anchor to the top of the listitem (using a top margin as well)
@@ -86,8 +93,9 @@ public:
         return that->d_func();
     }
 
+    void mirrorChange() override;
+
     void _q_onGuValueChanged();
-    void _q_updateCachedHeight();
     void _q_updateProgressionStatus();
     void _q_updateGuValues();
     void _q_updateCachedMainSlotHeight();
@@ -110,6 +118,10 @@ public:
 
     QQuickItem* mainSlot;
 
+    //attached properties of the children, so that we don't have to query the
+    //qml engine on every relayout
+    QHash<QQuickItem *, UCSlotsAttached *> attachedSlots;
+
     //We cache the current parent so that we can disconnect from the signals when the
     //parent changes. We need this because itemChange(..) only provides the new parent
     QQuickItem *m_parentItem;
@@ -117,9 +129,6 @@ public:
     qreal mainSlotHeight;
     //max slots height ignoring the main slot
     qreal maxSlotsHeight;
-    //we cache the height so that we only relayout when it goes
-    //from 0 to non-0 and not viceversa
-    qreal _q_cachedHeight;
 
     //currently fixed, but we may allow changing this in the future
     qint32 maxNumberOfLeadingSlots;
@@ -127,6 +136,8 @@ public:
 
     //Show the chevron, name taken from old ListItem API to minimize changes
     bool progression : 1;
+    //set when a relayout has been scheduled for the next polish
+    bool layoutDirty : 1;
 };
 
 class UCSlotsAttachedPrivate : public QObjectPrivate
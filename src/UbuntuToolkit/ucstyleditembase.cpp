@@ -346,6 +346,7 @@ void UCStyledItemBasePrivate::preStyleChanged()
     if (styleItem) {
         // make sure the context holder is reset too
         styleItemContext.clear();
+        themeStyleUrl.clear();
         // disconnect the size changes if they were still connected
         connectStyleSizeChanges(false);
         // remove parentalship to avoid eventual binding loops
@@ -410,6 +411,7 @@ bool UCStyledItemBasePrivate::loadStyleItem(bool animated)
     component->completeCreate();
     // delete temporary component
     if (!styleComponent) {
+        themeStyleUrl = component->url();
         delete component;
     }
 
@@ -509,6 +511,31 @@ void UCStyledItemBase::preThemeChanged()
     d->wasStyleLoaded = (d->styleItem != Q_NULLPTR);
     d->preStyleChanged();
 }
+
+// returns true if the current theme resolves the style document to the one
+// the style item was created from
+bool UCStyledItemBasePrivate::isThemeStyleUnchanged()
+{
+    if (!styleItem || styleComponent || themeStyleUrl.isEmpty()) {
+        return false;
+    }
+    Q_Q(UCStyledItemBase);
+    UCTheme *theme = q->getTheme();
+    return theme && (theme->styleUrl(styleDocument + ".qml", styleVersion) == themeStyleUrl);
+}
+
+// styles the reloaded theme shares with the previous one (i.e. the ones SuruDark
+// inherits from Ambiance) are kept, their palette bindings follow the new palette
+void UCStyledItemBase::themeReloaded()
+{
+    Q_D(UCStyledItemBase);
+    if (d->isThemeStyleUnchanged()) {
+        Q_EMIT themeChanged();
+        return;
+    }
+    UCThemingExtension::themeReloaded();
+}
+
 void UCStyledItemBase::postThemeChanged()
 {
     Q_EMIT themeChanged();
@@ -76,6 +76,7 @@ protected:
     // from UCThemingExtension interface
     void preThemeChanged() override;
     void postThemeChanged() override;
+    void themeReloaded() override;
 
     void classBegin() override;
     void componentComplete() override;
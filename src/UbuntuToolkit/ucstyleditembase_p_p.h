@@ -62,6 +62,7 @@ public:
     virtual void postStyleChanged() {}
     virtual bool loadStyleItem(bool animated = true);
     virtual void completeComponentInitialization();
+    bool isThemeStyleUnchanged();
 
     // from UCImportVersionChecker
     QString propertyForVersion(quint16 version) const override;
@@ -69,6 +70,8 @@ public:
 public:
 
     QPointer<QQmlContext> styleItemContext;
+    // the theme style document the style item was created from
+    QUrl themeStyleUrl;
     QString styleDocument;
     QQuickItem *oldParentItem;
     QQmlComponent *styleComponent;
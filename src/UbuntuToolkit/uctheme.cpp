@@ -399,6 +399,7 @@ UCTheme::UCTheme(QObject *parent)
     : QObject(parent)
     , m_parentTheme(Q_NULLPTR)
     , m_palette(Q_NULLPTR)
+    , m_paletteVersion(0)
     , m_completed(false)
 {
     init();
@@ -454,11 +455,17 @@ void UCTheme::updateEnginePaths(QQmlEngine *engine)
     if (!engine) {
         return;
     }
+    if (m_snapshotEngine.data() != engine) {
+        // palettes are created in the engine
+        clearSnapshots();
+        m_snapshotEngine = engine;
+    }
 
     QStringList paths = themeSearchPath();
     Q_FOREACH(const QString &path, paths) {
         if (QDir(path).exists() && !engine->importPathList().contains(path)) {
             engine->addImportPath(path);
+            clearSnapshots();
         }
     }
 }
@@ -472,8 +479,21 @@ void UCTheme::_q_defaultThemeChanged()
 void UCTheme::updateThemePaths()
 {
     m_themePaths.clear();
+    m_styleUrls.clear();
 
     QString themeName = name();
+    const QStringList searchPath = themeSearchPath();
+    if (searchPath != m_snapshotSearchPath) {
+        clearSnapshots();
+        m_snapshotSearchPath = searchPath;
+    }
+    QHash<QPair<QString, quint16>, Snapshot>::const_iterator snapshot = m_snapshots.constFind(
+        qMakePair(themeName, previousVersion ? previousVersion : LATEST_UITK_VERSION));
+    if (snapshot != m_snapshots.constEnd()) {
+        m_themePaths = snapshot->themePaths;
+        m_styleUrls = snapshot->styleUrls;
+        return;
+    }
     while (!themeName.isEmpty()) {
         ThemeRecord themePath = pathFromThemeName(themeName);
         if (themePath.isValid()) {
@@ -483,6 +503,34 @@ void UCTheme::updateThemePaths()
     }
 }
 
+// stores the resolved state of the current theme, detaching its palette
+void UCTheme::saveSnapshot()
+{
+    const quint16 version = m_paletteVersion ? m_paletteVersion
+        : (previousVersion ? previousVersion : LATEST_UITK_VERSION);
+    Snapshot &snapshot = m_snapshots[qMakePair(name(), version)];
+    snapshot.themePaths = m_themePaths;
+    snapshot.styleUrls = m_styleUrls;
+    if (m_palette) {
+        m_config.restorePalette();
+        // keep only the palettes owned by the theme, others may be shared
+        if (m_palette->parent() == this) {
+            snapshot.palette = m_palette;
+        }
+        m_palette = Q_NULLPTR;
+    }
+}
+
+void UCTheme::clearSnapshots()
+{
+    Q_FOREACH(const Snapshot &snapshot, m_snapshots) {
+        if (snapshot.palette && snapshot.palette != m_palette) {
+            delete snapshot.palette.data();
+        }
+    }
+    m_snapshots.clear();
+}
+
 /*!
  * \qmlproperty ThemeSettings ThemeSettings::parentTheme
  * \readonly
@@ -516,6 +564,7 @@ void UCTheme::setName(const QString& name)
     if (name == m_name) {
         return;
     }
+    saveSnapshot();
     m_name = name;
     if (name.isEmpty()) {
         init();
@@ -635,6 +684,24 @@ void UCTheme::resetPalette()
 }
 
 QUrl UCTheme::styleUrl(const QString& styleName, quint16 version, bool *isFallback)
+{
+    // styles are resolved for every styled item instance (i.e. each ListItem
+    // delegate on its first swipe), so cache the lookup to avoid hitting the
+    // file system each time
+    const QPair<QString, quint16> key(styleName, version);
+    QHash<QPair<QString, quint16>, QPair<QUrl, bool> >::const_iterator cached = m_styleUrls.constFind(key);
+    if (cached == m_styleUrls.constEnd()) {
+        bool fallback = false;
+        QUrl url = resolveStyleUrl(styleName, version, &fallback);
+        cached = m_styleUrls.insert(key, qMakePair(url, fallback));
+    }
+    if (isFallback) {
+        (*isFallback) = cached.value().second;
+    }
+    return cached.value().first;
+}
+
+QUrl UCTheme::resolveStyleUrl(const QString& styleName, quint16 version, bool *isFallback)
 {
     if (isFallback) {
         (*isFallback) = false;
@@ -796,9 +863,19 @@ void UCTheme::loadPalette(QQmlEngine *engine, bool notify)
         delete m_palette;
         m_palette = 0;
     }
+    // reuse the palette of the snapshot
+    m_paletteVersion = previousVersion ? previousVersion : LATEST_UITK_VERSION;
+    QObject *snapshotPalette = m_snapshots.value(qMakePair(name(), m_paletteVersion)).palette;
+    if (snapshotPalette) {
+        m_palette = snapshotPalette;
+        m_config.configurePalette(m_palette);
+        if (notify) {
+            Q_EMIT paletteChanged();
+        }
+        return;
+    }
     // theme may not have palette defined
-    QUrl paletteUrl = styleUrl(
-        QStringLiteral("Palette.qml"), previousVersion ? previousVersion : LATEST_UITK_VERSION);
+    QUrl paletteUrl = styleUrl(QStringLiteral("Palette.qml"), m_paletteVersion);
     if (paletteUrl.isValid()) {
         m_palette = QuickUtils::instance()->createQmlObject(paletteUrl, engine);
         if (m_palette) {
@@ -20,9 +20,12 @@
 #ifndef UCTHEME_P_H
 #define UCTHEME_P_H
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QPair>
 #include <QtCore/QPointer>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 #include <QtCore/QUrl>
 #include <QtQml/QQmlComponent>
 #include <QtQml/QQmlParserStatus>
@@ -86,6 +89,7 @@ public:
 
     // internal, used by the deprecated Theme.createStyledComponent()
     QQmlComponent* createStyleComponent(const QString& styleName, QObject* parent, quint16 version = 0);
+    QUrl styleUrl(const QString& styleName, quint16 version, bool *isFallback = NULL);
     void attachItem(QQuickItem *item, bool attach);
 
     // helper functions
@@ -114,7 +118,9 @@ private:
     void init();
     void updateEnginePaths(QQmlEngine *engine);
     void updateThemePaths();
-    QUrl styleUrl(const QString& styleName, quint16 version, bool *isFallback = NULL);
+    void saveSnapshot();
+    void clearSnapshots();
+    QUrl resolveStyleUrl(const QString& styleName, quint16 version, bool *isFallback);
     void loadPalette(QQmlEngine *engine, bool notify = true);
     void updateThemedItems();
 
@@ -172,6 +178,22 @@ private:
     QPointer<UCTheme> m_parentTheme;
     QPointer<QObject> m_palette; // the palette might be from the default style if the theme doesn't define palette
     QList<ThemeRecord> m_themePaths;
+    // resolved style URLs keyed by style document and version, the flag tells
+    // whether the URL is a fallback; cleared when the theme paths change
+    QHash<QPair<QString, quint16>, QPair<QUrl, bool> > m_styleUrls;
+    // resolved state of the themes used before, keyed by theme name and palette
+    // version, swapped in when switching back to one of them instead of resolving
+    // the paths and loading the palette again; cleared when the engine or the
+    // theme search paths change
+    struct Snapshot {
+        QList<ThemeRecord> themePaths;
+        QHash<QPair<QString, quint16>, QPair<QUrl, bool> > styleUrls;
+        QPointer<QObject> palette;
+    };
+    QHash<QPair<QString, quint16>, Snapshot> m_snapshots;
+    QStringList m_snapshotSearchPath;
+    QPointer<QQmlEngine> m_snapshotEngine;
+    quint16 m_paletteVersion;
     UCDefaultTheme m_defaultTheme;
     QPODVector<QQuickItem*, 4> m_attachedItems;
     bool m_completed:1;
@@ -219,14 +219,12 @@ void UCThemingExtension::itemThemeReloaded(UCTheme *theme)
 {
     switch (themeType) {
     case Inherited: {
-        preThemeChanged();
-        postThemeChanged();
+        themeReloaded();
         return;
     }
     case Custom: {
         if (theme == this->theme) {
-            preThemeChanged();
-            postThemeChanged();
+            themeReloaded();
             // forward to children
             notifyThemeReloaded(themedItem, theme);
         } else {
@@ -239,6 +237,13 @@ void UCThemingExtension::itemThemeReloaded(UCTheme *theme)
     }
 }
 
+// called when the theme of the item got reloaded (i.e. its name changed)
+void UCThemingExtension::themeReloaded()
+{
+    preThemeChanged();
+    postThemeChanged();
+}
+
 UCTheme *UCThemingExtension::getTheme()
 {
     if (!theme) {
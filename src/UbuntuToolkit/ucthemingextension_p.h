@@ -55,6 +55,9 @@ public:
     static bool isThemed(QQuickItem *item);
     static QQuickItem *ascendantThemed(QQuickItem *item);
 
+protected:
+    virtual void themeReloaded();
+
 private:
     QPointer<UCTheme> theme;
     QQuickItem *themedItem;
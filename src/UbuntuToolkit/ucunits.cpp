@@ -28,7 +28,9 @@
 #include <QtGui/qpa/qplatformwindow.h>
 #include <QtGui/qpa/qplatformscreen.h>
 #include <QtQml/QQmlContext>
+#include <QtQml/QQmlEngine>
 #include <QtQml/QQmlFile>
+#include <QtQml/private/qqmlengine_p.h>
 
 #define ENV_GRID_UNIT_PX "GRID_UNIT_PX"
 #define DEFAULT_GRID_UNIT_PX 8
@@ -99,9 +101,13 @@ static float getenvFloat(const char* name, float defaultValue)
 
 UCUnits::UCUnits(QWindow *parent) :
     QObject(parent),
-    m_devicePixelRatio(parent->devicePixelRatio())
+    m_engine(Q_NULLPTR),
+    m_devicePixelRatio(parent->devicePixelRatio()),
+    m_screen(Q_NULLPTR),
+    m_notifyPending(false)
 {
     m_gridUnit = getenvFloat(ENV_GRID_UNIT_PX, DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
+    m_notifiedGridUnit = m_gridUnit;
 
     if (!qEnvironmentVariableIsSet(ENV_GRID_UNIT_PX)) {
         QObject::connect(parent, &QWindow::screenChanged,
@@ -122,22 +128,26 @@ void UCUnits::screenChanged(QScreen *screen)
     QObject::connect(m_screen, &QScreen::physicalDotsPerInchChanged,
                      this, &UCUnits::devicePixelRatioChanged);
     m_devicePixelRatio = screen->devicePixelRatio();
-    setGridUnit(DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
+    scheduleGridUnit(DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
 }
 
 void UCUnits::devicePixelRatioChanged(qreal dpi)
 {
     m_devicePixelRatio = dpi;
-    setGridUnit(DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
+    scheduleGridUnit(DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
 }
 
 UCUnits *UCUnits::m_units = nullptr;
 
 UCUnits::UCUnits(QObject *parent) :
     QObject(parent),
-    m_devicePixelRatio(qGuiApp->devicePixelRatio())
+    m_engine(qobject_cast<QQmlEngine*>(parent)),
+    m_devicePixelRatio(qGuiApp->devicePixelRatio()),
+    m_screen(Q_NULLPTR),
+    m_notifyPending(false)
 {
     m_gridUnit = getenvFloat(ENV_GRID_UNIT_PX, DEFAULT_GRID_UNIT_PX * m_devicePixelRatio);
+    m_notifiedGridUnit = m_gridUnit;
 
     if (!qEnvironmentVariableIsSet(ENV_GRID_UNIT_PX)) {
         auto nativeInterface = qGuiApp->platformNativeInterface();
@@ -164,12 +174,61 @@ float UCUnits::gridUnit()
 }
 
 void UCUnits::setGridUnit(float gridUnit)
+{
+    if (updateGridUnit(gridUnit)) {
+        notifyGridUnitChanged();
+    }
+}
+
+bool UCUnits::updateGridUnit(float gridUnit)
 {
     if (qFuzzyCompare(gridUnit, m_gridUnit)) {
-        return;
+        return false;
     }
     m_gridUnit = gridUnit;
+    return true;
+}
+
+/*
+ * Screen, scale and DPI changes come in bursts when docking or plugging in an
+ * external monitor. The new value is returned by gu() and dp() right away, but
+ * the change is only announced once the burst is over, so the bindings depending
+ * on the grid unit get re-evaluated once.
+ */
+void UCUnits::scheduleGridUnit(float gridUnit)
+{
+    if (updateGridUnit(gridUnit) && !m_notifyPending) {
+        m_notifyPending = true;
+        QMetaObject::invokeMethod(this, "notifyGridUnitChanged", Qt::QueuedConnection);
+    }
+}
+
+void UCUnits::notifyGridUnitChanged()
+{
+    m_notifyPending = false;
+    if (qFuzzyCompare(m_notifiedGridUnit, m_gridUnit)) {
+        return;
+    }
+    m_notifiedGridUnit = m_gridUnit;
     Q_EMIT gridUnitChanged();
+    m_gridUnitNotifier.notify();
+}
+
+/*
+ * Makes the binding being evaluated, if any, depend on the grid unit, the same
+ * way reading a notifiable property would. Bindings calling gu() or dp() (also
+ * through FontUtils) are then re-evaluated when the grid unit changes, without
+ * resetting the context property and with it every binding touching "units".
+ */
+void UCUnits::captureGridUnit()
+{
+    if (!m_engine) {
+        return;
+    }
+    QQmlEnginePrivate *engine = QQmlEnginePrivate::get(m_engine);
+    if (engine->propertyCapture) {
+        engine->propertyCapture->captureProperty(&m_gridUnitNotifier);
+    }
 }
 
 /*!
@@ -180,6 +239,7 @@ void UCUnits::setGridUnit(float gridUnit)
 // Density-independent pixels (and not physical pixels) because Qt sizes in terms of density-independent pixels.
 float UCUnits::dp(float value)
 {
+    captureGridUnit();
     const float ratio = m_gridUnit / DEFAULT_GRID_UNIT_PX;
     if (value <= 2.0) {
         // for values under 2dp, return only multiples of the value
@@ -198,6 +258,7 @@ float UCUnits::dp(float value)
 
 float UCUnits::gu(float value)
 {
+    captureGridUnit();
     return qRound(value * m_gridUnit) / m_devicePixelRatio;
 }
 
@@ -328,7 +389,7 @@ void UCUnits::windowPropertyChanged(QPlatformWindow *window, const QString &prop
         return;
     }
     // choose integral grid unit value closest to requested scale
-    setGridUnit(qCeil(scale * DEFAULT_GRID_UNIT_PX) * m_devicePixelRatio);
+    scheduleGridUnit(qCeil(scale * DEFAULT_GRID_UNIT_PX) * m_devicePixelRatio);
 }
 
 UT_NAMESPACE_END
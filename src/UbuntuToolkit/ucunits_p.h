@@ -24,10 +24,12 @@
 #include <QtCore/QString>
 #include <QtCore/QUrl>
 #include <QtGui/QWindow>
+#include <QtQml/private/qqmlnotifier_p.h>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
 
 class QPlatformWindow;
+class QQmlEngine;
 
 UT_NAMESPACE_BEGIN
 
@@ -67,17 +69,25 @@ Q_SIGNALS:
 protected:
     QString suffixForGridUnit(float gridUnit);
     float gridUnitSuffixFromFileName(const QString &fileName);
+    bool updateGridUnit(float gridUnit);
+    void scheduleGridUnit(float gridUnit);
+    void captureGridUnit();
 
 private Q_SLOTS:
     void windowPropertyChanged(QPlatformWindow *window, const QString &propertyName);
     void screenChanged(QScreen *screen);
     void devicePixelRatioChanged(qreal dpi);
+    void notifyGridUnitChanged();
 
 private:
     static UCUnits *m_units;
+    QQmlEngine *m_engine;
+    QQmlNotifier m_gridUnitNotifier;
     float m_devicePixelRatio;
     QScreen *m_screen;
     float m_gridUnit;
+    float m_notifiedGridUnit;
+    bool m_notifyPending:1;
 };
 
 UT_NAMESPACE_END
@@ -19,6 +19,7 @@
 #include <QtQml/private/qqmlcomponentattached_p.h>
 #include <QtQml/private/qqmldelegatemodel_p.h>
 #include <QtQml/private/qqmlobjectmodel_p.h>
+#include <QtQml/private/qqmlpropertycache_p.h>
 #include <QtQuick/private/qquickflickable_p.h>
 
 #include "i18n_p.h"
@@ -107,16 +108,23 @@ UCViewItemsAttachedPrivate::UCViewItemsAttachedPrivate()
     : QObjectPrivate()
     , listView(0)
     , dragArea(0)
+    , versionPropertyCache(Q_NULLPTR)
     , expansionFlags(UCViewItemsAttached::Exclusive)
+    , delegateVersion(0)
     , selectable(false)
     , draggable(false)
     , ready(false)
+    , selectionNotifyPending(false)
+    , modelMovedRows(false)
 {
 }
 
 UCViewItemsAttachedPrivate::~UCViewItemsAttachedPrivate()
 {
     clearFlickablesList();
+    if (versionPropertyCache) {
+        versionPropertyCache->release();
+    }
 }
 
 void UCViewItemsAttachedPrivate::init()
@@ -129,6 +137,9 @@ void UCViewItemsAttachedPrivate::init()
         listView->view()->setActiveFocusOnTab(true);
         // filter ListView events to override up/down focus handling
         listView->overrideItemNavigation(true);
+
+        QObject::connect(parent, SIGNAL(modelChanged()), q, SLOT(_q_trackModel()));
+        _q_trackModel();
     }
     // listen readyness
     QQmlComponentAttached *attached = QQmlComponent::qmlAttachedProperties(parent);
@@ -298,6 +309,10 @@ void UCViewItemsAttached::setSelectMode(bool value)
  * indexes are model indexes when used in ListView, and child indexes in other
  * components. The property being writable, initial selection configuration
  * can be provided for a view, and provides ability to save the selection state.
+ * The indexes are listed in ascending order. Changes done within the same event
+ * loop iteration are notified once.
+ * \note When the ListView's model is a ListModel or a QAbstractItemModel, the
+ * indexes follow the rows inserted, removed or moved in the model.
  */
 QList<int> UCViewItemsAttached::selectedIndices() const
 {
@@ -307,27 +322,93 @@ QList<int> UCViewItemsAttached::selectedIndices() const
 void UCViewItemsAttached::setSelectedIndices(const QList<int> &list)
 {
     Q_D(UCViewItemsAttached);
-    if (d->selectedList.toList() == list) {
+    ListItemSelectionRanges selection = ListItemSelectionRanges::fromList(list);
+    if (d->selectedList == selection) {
         return;
     }
-    d->selectedList = QSet<int>::fromList(list);
-    Q_EMIT selectedIndicesChanged(list);
+    d->selectedList = selection;
+    d->notifySelectedIndicesChanged();
+}
+
+/*!
+ * \qmlattachedmethod void ViewItems::selectAll()
+ * \since Ubuntu.Components 1.3
+ * Selects all the ListItems of the view.
+ */
+void UCViewItemsAttached::selectAll()
+{
+    Q_D(UCViewItemsAttached);
+    selectRange(0, d->itemCount() - 1);
+}
+
+/*!
+ * \qmlattachedmethod void ViewItems::selectRange(int first, int last)
+ * \since Ubuntu.Components 1.3
+ * Adds the ListItems from index \a first to \a last, inclusive, to the selection.
+ * Indexes outside of the view's items are ignored.
+ */
+void UCViewItemsAttached::selectRange(int first, int last)
+{
+    Q_D(UCViewItemsAttached);
+    if (d->selectedList.insert(qMax(0, first), qMin(last, d->itemCount() - 1)) > 0) {
+        d->notifySelectedIndicesChanged();
+    }
+}
+
+/*!
+ * \qmlattachedmethod void ViewItems::clearSelection()
+ * \since Ubuntu.Components 1.3
+ * Deselects all the ListItems of the view.
+ */
+void UCViewItemsAttached::clearSelection()
+{
+    Q_D(UCViewItemsAttached);
+    if (d->selectedList.count() > 0) {
+        d->selectedList.clear();
+        d->notifySelectedIndicesChanged();
+    }
+}
+
+// number of items the indexes refer to; model count in ListView, child count otherwise
+int UCViewItemsAttachedPrivate::itemCount()
+{
+    if (listView) {
+        return listView->count();
+    }
+    QQuickItem *item = qobject_cast<QQuickItem*>(parent);
+    return item ? item->childItems().count() : 0;
+}
+
+// the selection may change many times while handling one event (drag, select
+// all, bindings), emit the change only once for all of them
+void UCViewItemsAttachedPrivate::notifySelectedIndicesChanged()
+{
+    if (!selectionNotifyPending) {
+        selectionNotifyPending = true;
+        QMetaObject::invokeMethod(q_func(), "_q_notifySelectedIndices", Qt::QueuedConnection);
+    }
+}
+
+void UCViewItemsAttachedPrivate::_q_notifySelectedIndices()
+{
+    selectionNotifyPending = false;
+    Q_EMIT q_func()->selectedIndicesChanged(selectedList.toList());
 }
 
 bool UCViewItemsAttachedPrivate::addSelectedItem(UCListItem *item)
 {
     int index = UCListItemPrivate::get(item)->index();
-    if (!selectedList.contains(index)) {
-        selectedList.insert(index);
-        Q_EMIT q_func()->selectedIndicesChanged(selectedList.toList());
+    if (selectedList.insert(index, index) > 0) {
+        notifySelectedIndicesChanged();
         return true;
     }
     return false;
 }
 bool UCViewItemsAttachedPrivate::removeSelectedItem(UCListItem *item)
 {
-    if (selectedList.remove(UCListItemPrivate::get(item)->index()) > 0) {
-        Q_EMIT q_func()->selectedIndicesChanged(selectedList.toList());
+    int index = UCListItemPrivate::get(item)->index();
+    if (selectedList.remove(index, index) > 0) {
+        notifySelectedIndicesChanged();
         return true;
     }
     return false;
@@ -535,38 +616,73 @@ bool UCViewItemsAttachedPrivate::isDragUpdatedConnected()
 // updates the selected indices list in ViewAttached which is changed due to dragging
 void UCViewItemsAttachedPrivate::updateSelectedIndices(int fromIndex, int toIndex)
 {
-    if (selectedList.count() == listView->count()) {
-        // all indices selected, no need to reorder
+    if (modelMovedRows) {
+        // the model reported the move, the selection already follows it
+        modelMovedRows = false;
         return;
     }
+    if (selectedList.count() == 0 || selectedList.count() == listView->count()) {
+        // none or all indices selected, no need to reorder
+        return;
+    }
+    ListItemSelectionRanges previous = selectedList;
+    selectedList.move(fromIndex, toIndex, 1);
+    if (selectedList != previous) {
+        notifySelectedIndicesChanged();
+    }
+}
 
+// shifts the selected indices along with the rows inserted, removed or moved in
+// the ListView's model; list and number models are reset instead, so the
+// selection is left to the application for those
+void UCViewItemsAttachedPrivate::_q_trackModel()
+{
     Q_Q(UCViewItemsAttached);
-    bool isFromSelected = selectedList.contains(fromIndex);
-    if (isFromSelected) {
-        selectedList.remove(fromIndex);
-        Q_EMIT q->selectedIndicesChanged(selectedList.toList());
-    }
-    // direction is -1 (forwards) or 1 (backwards)
-    int direction = (fromIndex < toIndex) ? -1 : 1;
-    int i = (direction < 0) ? fromIndex + 1 : fromIndex - 1;
-    // loop thru the selectedIndices and fix all indices
-    while (1) {
-        if (((direction < 0) && (i > toIndex)) ||
-            ((direction > 0) && (i < toIndex))) {
-            break;
-        }
-
-        if (selectedList.contains(i)) {
-            selectedList.remove(i);
-            selectedList.insert(i + direction);
-            Q_EMIT q->selectedIndicesChanged(selectedList.toList());
-        }
-        i -= direction;
+    QVariant model = listView->model();
+    QQmlDelegateModel *delegateModel = model.value<QQmlDelegateModel*>();
+    if (delegateModel) {
+        model = delegateModel->model();
     }
-    if (isFromSelected) {
-        selectedList.insert(toIndex);
-        Q_EMIT q->selectedIndicesChanged(selectedList.toList());
+    QAbstractItemModel *itemModel = model.value<QAbstractItemModel*>();
+    if (trackedModel.data() == itemModel) {
+        return;
+    }
+    if (trackedModel) {
+        QObject::disconnect(trackedModel.data(), 0, q, 0);
     }
+    trackedModel = itemModel;
+    if (!itemModel) {
+        return;
+    }
+    QObject::connect(itemModel, &QAbstractItemModel::rowsInserted,
+                     q, [this](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid() && selectedList.count() > 0) {
+            selectedList.shiftInserted(first, last - first + 1);
+            notifySelectedIndicesChanged();
+        }
+    });
+    QObject::connect(itemModel, &QAbstractItemModel::rowsRemoved,
+                     q, [this](const QModelIndex &parent, int first, int last) {
+        if (!parent.isValid() && selectedList.count() > 0) {
+            selectedList.shiftRemoved(first, last - first + 1);
+            notifySelectedIndicesChanged();
+        }
+    });
+    QObject::connect(itemModel, &QAbstractItemModel::rowsMoved,
+                     q, [this](const QModelIndex &parent, int first, int last,
+                               const QModelIndex &destination, int row) {
+        if (parent.isValid() || destination.isValid()) {
+            return;
+        }
+        // the destination row is given before the rows are taken out
+        const int count = last - first + 1;
+        ListItemSelectionRanges previous = selectedList;
+        selectedList.move(first, row > first ? row - count : row, count);
+        if (selectedList != previous) {
+            notifySelectedIndicesChanged();
+        }
+        modelMovedRows = true;
+    });
 }
 
 /*!
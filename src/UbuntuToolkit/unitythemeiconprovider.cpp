@@ -275,13 +275,21 @@ private:
 };
 
 UnityThemeIconProvider::UnityThemeIconProvider(const QString &themeName):
-  QQuickImageProvider(QQuickImageProvider::Image)
+  QQuickImageProvider(QQuickImageProvider::Image),
+  themeName(themeName)
 {
-    theme = IconTheme::get(themeName);
 }
 
 QImage UnityThemeIconProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
 {
+    // parsing the theme hierarchy hits the disk, do not do it at plugin load
+    {
+        QMutexLocker lock(&themeMutex);
+        if (theme.isNull()) {
+            theme = IconTheme::get(themeName);
+        }
+    }
+
     // The hicolor theme will be searched last as per
     // https://specifications.freedesktop.org/icon-theme-spec/icon-theme-spec-latest.html
     QSet<QString> alreadySearchedThemes;
@@ -19,6 +19,7 @@
 #ifndef UNITYTHEMEICONPROVIDER_P_H
 #define UNITYTHEMEICONPROVIDER_P_H
 
+#include <QtCore/QMutex>
 #include <QtQuick/QQuickImageProvider>
 
 #include <UbuntuToolkit/ubuntutoolkitglobal.h>
@@ -32,7 +33,10 @@ public:
     QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
 
 private:
+    // the theme is only loaded when the first icon is requested
     QSharedPointer<class IconTheme> theme;
+    QString themeName;
+    QMutex themeMutex;
 };
 
 UT_NAMESPACE_END
@@ -55,6 +55,8 @@ public:
         WindowEvent  = UMApplicationMonitor::WindowEvent,
         FrameEvent   = UMApplicationMonitor::FrameEvent,
         GenericEvent = UMApplicationMonitor::GenericEvent,
+        InputEvent   = UMApplicationMonitor::InputEvent,
+        JankEvent    = UMApplicationMonitor::JankEvent,
         AllEvents    = UMApplicationMonitor::AllEvents
     };
     Q_DECLARE_FLAGS(LoggingFilters, LoggingFilter)
@@ -17,6 +17,12 @@
  */
 
 #include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QString>
 #include <QtCore/QTextCodec>
 #include <QtCore/QTimeZone>
@@ -107,10 +113,76 @@ private:
         return false;
     }
 
+    bool containsMessage(const QString &message)
+    {
+        for (int i = 0; i < AlarmManager::instance().alarmCount(); i++) {
+            if (AlarmManager::instance().alarmAt(i)->message() == message) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // creates todo items with distinct ids in a separate memory backend, with
+    // occurrences spread over the coming days in non-sorted order
+    QList<QOrganizerItem> createTodos(QOrganizerManager &manager, int count)
+    {
+        QList<QOrganizerItem> items;
+        QDateTime base = QDateTime::currentDateTime().addDays(1);
+        for (int i = 0; i < count; i++) {
+            QOrganizerTodo todo;
+            todo.setStartDateTime(base.addSecs((i * 7919) % count * 60));
+            todo.setDisplayLabel(QString("test_alarmList_%1").arg(i));
+            items.append(todo);
+        }
+        manager.saveItems(&items);
+        return items;
+    }
+
+    void fillAlarmList(AlarmList &list, const QList<QOrganizerItem> &items)
+    {
+        UCAlarm alarm;
+        AlarmDataAdapter *pAlarm = static_cast<AlarmDataAdapter*>(UCAlarmPrivate::get(&alarm));
+        Q_FOREACH(const QOrganizerItem &item, items) {
+            pAlarm->setData(QOrganizerTodo(item));
+            list.insert(alarm);
+        }
+    }
+
+    // JSON alarm data as stored by the fallback manager
+    QJsonObject alarmObject(const QString &id, const QString &message, const QDateTime &date)
+    {
+        QJsonObject object;
+        object["id"] = id;
+        object["message"] = message;
+        object["date"] = date.toString();
+        object["sound"] = QString();
+        object["type"] = QJsonValue(UCAlarm::OneTime);
+        object["days"] = QJsonValue(UCAlarm::AutoDetect);
+        object["enabled"] = true;
+        return object;
+    }
+
+    QJsonArray readDatabase()
+    {
+        QFile file(dataPath() + "/alarms.json");
+        if (!file.open(QFile::ReadOnly)) {
+            return QJsonArray();
+        }
+        return QJsonDocument::fromJson(file.readAll()).array();
+    }
+
+    QString dataPath()
+    {
+        return QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
     {
+        // keep the alarm database and journal out of the user's data folder
+        QStandardPaths::setTestModeEnabled(true);
         engine = new QQmlEngine;
         UbuntuToolkitModule::initializeContextProperties(engine);
 
@@ -590,6 +662,143 @@ private Q_SLOTS:
         // check the tags
         QVERIFY(AlarmManager::instance().verifyChange(&alarm, AlarmManager::Enabled, enabled));
     }
+
+    void test_journal_replayed_on_load()
+    {
+        AlarmsAdapter *adapter = AlarmsAdapter::get();
+        if (adapter->manager->managerName() != "memory") {
+            QSKIP("The journal is used by the fallback alarm manager only");
+        }
+        QDir().mkpath(dataPath());
+        QDateTime date = QDateTime::currentDateTime().addDays(2);
+
+        // database snapshot with two alarms
+        QJsonArray snapshot;
+        snapshot.append(alarmObject("first", "test_journal_first", date));
+        snapshot.append(alarmObject("second", "test_journal_removed", date.addSecs(60)));
+        QFile database(dataPath() + "/alarms.json");
+        QVERIFY(database.open(QFile::WriteOnly | QFile::Truncate));
+        database.write(QJsonDocument(snapshot).toJson());
+        database.close();
+
+        // journal removing the second, adding a third and updating the first alarm
+        QFile journal(dataPath() + "/alarms.journal");
+        QVERIFY(journal.open(QFile::WriteOnly | QFile::Truncate));
+        QJsonObject remove;
+        remove["id"] = QStringLiteral("second");
+        remove["operation"] = QStringLiteral("remove");
+        QJsonObject add = alarmObject("third", "test_journal_added", date.addSecs(120));
+        add["operation"] = QStringLiteral("save");
+        QJsonObject update = alarmObject("first", "test_journal_updated", date.addSecs(180));
+        update["operation"] = QStringLiteral("save");
+        Q_FOREACH(const QJsonObject &entry, QList<QJsonObject>() << remove << add << update) {
+            journal.write(QJsonDocument(entry).toJson(QJsonDocument::Compact));
+            journal.write("\n");
+        }
+        journal.close();
+
+        adapter->loadAlarms();
+
+        // replayed alarms are compacted into the database with the IDs of this session
+        QVERIFY(!QFile::exists(dataPath() + "/alarms.journal"));
+        QJsonArray data = readDatabase();
+        QCOMPARE(data.count(), 2);
+        QCOMPARE(data[0].toObject()["message"].toString(), QString("test_journal_updated"));
+        QCOMPARE(data[1].toObject()["message"].toString(), QString("test_journal_added"));
+        for (int i = 0; i < data.count(); i++) {
+            QString id = data[i].toObject()["id"].toString();
+            QVERIFY(!id.isEmpty());
+            QVERIFY(id != "first" && id != "third");
+            QOrganizerItemId itemId = QOrganizerItemId::fromString(id);
+            QCOMPARE(adapter->manager->item(itemId).displayLabel(),
+                     data[i].toObject()["message"].toString());
+        }
+        // the replayed alarms are reported by the organizer as well
+        QTRY_VERIFY(containsMessage("test_journal_updated") && containsMessage("test_journal_added"));
+        QVERIFY(!containsMessage("test_journal_removed"));
+    }
+
+    void test_journal_compacted_over_limit()
+    {
+        AlarmsAdapter *adapter = AlarmsAdapter::get();
+        if (adapter->manager->managerName() != "memory") {
+            QSKIP("The journal is used by the fallback alarm manager only");
+        }
+        // start from a compacted database
+        adapter->saveAlarms();
+        QVERIFY(QFile::exists(dataPath() + "/alarms.json"));
+        QVERIFY(!QFile::exists(dataPath() + "/alarms.journal"));
+
+        QOrganizerManager manager("memory");
+        QList<QOrganizerItem> items = createTodos(manager, 101);
+        QList<AlarmsAdapter::Operation> operations;
+        Q_FOREACH(const QOrganizerItem &item, items) {
+            operations << AlarmsAdapter::Operation(item.id(), QOrganizerManager::Remove);
+        }
+
+        // changes under the limit are appended to the journal
+        adapter->journalAlarms(operations.mid(0, 1));
+        QFile journal(dataPath() + "/alarms.journal");
+        QVERIFY(journal.open(QFile::ReadOnly));
+        QCOMPARE(journal.readAll().count('\n'), 1);
+        journal.close();
+
+        // over the limit the journal is compacted into the database
+        adapter->journalAlarms(operations.mid(1));
+        QVERIFY(!QFile::exists(dataPath() + "/alarms.journal"));
+        QCOMPARE(readDatabase().count(), adapter->alarmCount());
+    }
+
+    void test_alarmListOrder()
+    {
+        QOrganizerManager manager("memory");
+        QList<QOrganizerItem> items = createTodos(manager, 100);
+        AlarmList list;
+        fillAlarmList(list, items);
+        QCOMPARE(list.count(), items.count());
+
+        for (int i = 1; i < list.count(); i++) {
+            QVERIFY(list[i - 1]->date() <= list[i]->date());
+        }
+        Q_FOREACH(const QOrganizerItem &item, items) {
+            int index = list.indexOf(item.id());
+            QVERIFY(index >= 0);
+            QCOMPARE(list[index]->cookie().value<QOrganizerItemId>(), item.id());
+        }
+
+        // move the first alarm to the end
+        UCAlarm alarm;
+        UCAlarmPrivate::get(&alarm)->copyAlarmData(*list[0]);
+        QOrganizerItemId id = alarm.cookie().value<QOrganizerItemId>();
+        alarm.setDate(list[list.count() - 1]->date().addDays(1));
+        QCOMPARE(list.update(0, alarm), list.count() - 1);
+        QCOMPARE(list.indexOf(id), list.count() - 1);
+
+        list.removeAt(list.count() - 1);
+        QCOMPARE(list.indexOf(id), -1);
+        QCOMPARE(list.count(), items.count() - 1);
+        list.clear();
+    }
+
+    void benchmark_alarmList()
+    {
+        QOrganizerManager manager("memory");
+        QList<QOrganizerItem> items = createTodos(manager, 10000);
+        AlarmList list;
+        fillAlarmList(list, items);
+        QCOMPARE(list.count(), 10000);
+
+        // what a view does: positional access to every row plus id lookups
+        QBENCHMARK {
+            for (int i = 0; i < list.count(); i++) {
+                QVERIFY(list[i]);
+            }
+            Q_FOREACH(const QOrganizerItem &item, items) {
+                list.indexOf(item.id());
+            }
+        }
+        list.clear();
+    }
 };
 
 QTEST_MAIN(tst_UCAlarms)
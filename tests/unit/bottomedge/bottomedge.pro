@@ -26,4 +26,5 @@ DISTFILES += \
     PreloadedContent.qml \
     BottomEdgeWithAction.qml \
     PreloadContentUrl.qml \
-    ExternalContent.qml
+    ExternalContent.qml \
+    RetainedContent.qml
@@ -120,6 +120,18 @@ class tst_BottomEdge : public QObject
 {
     Q_OBJECT
     QStringList regionObjects;
+
+    // drags upwards till the given drag progress, from the current touch point
+    void dragUpwards(UCBottomEdge *bottomEdge, QPoint &movePos, qreal progress)
+    {
+        int toY = bottomEdge->height() * (1.0 - progress);
+        while (movePos.y() > toY) {
+            QTest::qWait(20);
+            UCTestExtras::touchMove(0, bottomEdge, movePos);
+            movePos += QPoint(0, -10);
+        }
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -983,6 +995,126 @@ private Q_SLOTS:
         QTRY_VERIFY_WITH_TIMEOUT(UCBottomEdgeRegionPrivate::get(d->regions[0])->contentItem != nullptr, 1000);
     }
 
+    void test_exited_region_content_retained()
+    {
+        QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase("RetainedContent.qml"));
+        UCBottomEdge *bottomEdge = test->testItem();
+        UCBottomEdgePrivate *d = UCBottomEdgePrivate::get(bottomEdge);
+        UCBottomEdgeRegionPrivate *region1 = UCBottomEdgeRegionPrivate::get(d->regions[0]);
+
+        // drag through the first region into the second one
+        QPoint from(bottomEdge->width() / 2.0f, bottomEdge->height() - 5);
+        QPoint to = from + QPoint(0, -(bottomEdge->height() * 0.6));
+        UCTestExtras::touchPress(0, bottomEdge, from);
+        QPoint movePos(from);
+        while (movePos.y() > to.y()) {
+            QTest::qWait(20);
+            UCTestExtras::touchMove(0, bottomEdge, movePos);
+            movePos += QPoint(0, -10);
+        }
+        QCOMPARE(d->activeRegion, d->regions[1]);
+        QTRY_VERIFY_WITH_TIMEOUT(region1->contentItem != nullptr, 1000);
+        QPointer<QQuickItem> content1(region1->contentItem);
+
+        // drag back into the first region, the content must not be reloaded
+        to = from + QPoint(0, -(bottomEdge->height() * 0.35));
+        while (movePos.y() < to.y()) {
+            QTest::qWait(20);
+            UCTestExtras::touchMove(0, bottomEdge, movePos);
+            movePos += QPoint(0, 10);
+        }
+        QCOMPARE(d->activeRegion, d->regions[0]);
+        QCOMPARE(region1->contentItem, content1.data());
+        QCOMPARE(bottomEdge->contentItem(), content1.data());
+        QTest::qWait(20);
+        UCTestExtras::touchRelease(0, bottomEdge, movePos);
+    }
+
+    void test_retained_regions_budget()
+    {
+        QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase("RetainedContent.qml"));
+        UCBottomEdge *bottomEdge = test->testItem();
+        UCBottomEdgePrivate *d = UCBottomEdgePrivate::get(bottomEdge);
+        UCBottomEdgeRegionPrivate *region1 = UCBottomEdgeRegionPrivate::get(d->regions[0]);
+        UCBottomEdgeRegionPrivate *region2 = UCBottomEdgeRegionPrivate::get(d->regions[1]);
+        d->retainedRegionsBudget = 1;
+
+        d->retainRegionContent(d->regions[0]);
+        QTRY_VERIFY_WITH_TIMEOUT(region1->contentItem != nullptr, 1000);
+
+        // the least recently used region is discarded
+        d->retainRegionContent(d->regions[1]);
+        QTRY_VERIFY_WITH_TIMEOUT(region2->contentItem != nullptr, 1000);
+        QVERIFY(!region1->contentItem);
+        QVERIFY(!region1->retained);
+        QCOMPARE(d->retainedRegions.size(), 1);
+
+        // no budget, no retention
+        d->retainedRegionsBudget = 0;
+        d->releaseRegionContent(d->regions[1]);
+        d->retainRegionContent(d->regions[0]);
+        QVERIFY(!region1->contentItem);
+        QVERIFY(d->retainedRegions.isEmpty());
+    }
+
+    void test_exited_regions_released_over_budget()
+    {
+        QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase("RetainedContent.qml"));
+        UCBottomEdge *bottomEdge = test->testItem();
+        UCBottomEdgePrivate *d = UCBottomEdgePrivate::get(bottomEdge);
+        UCBottomEdgeRegionPrivate *region1 = UCBottomEdgeRegionPrivate::get(d->regions[0]);
+        d->retainedRegionsBudget = 1;
+
+        QPoint movePos(bottomEdge->width() / 2.0f, bottomEdge->height() - 5);
+        UCTestExtras::touchPress(0, bottomEdge, movePos);
+        dragUpwards(bottomEdge, movePos, 0.4);
+        QCOMPARE(d->activeRegion, d->regions[0]);
+        QTRY_VERIFY_WITH_TIMEOUT(region1->contentItem != nullptr, 1000);
+        QPointer<QQuickItem> content1(region1->contentItem);
+
+        dragUpwards(bottomEdge, movePos, 0.6);
+        QCOMPARE(d->activeRegion, d->regions[1]);
+
+        // exiting the second region takes the only retention slot, the first
+        // region's content is released
+        dragUpwards(bottomEdge, movePos, 0.8);
+        QCOMPARE(d->activeRegion, d->regions[2]);
+        QCOMPARE(d->retainedRegions.size(), 1);
+        QVERIFY(!d->retainedRegions.contains(d->regions[0]));
+        QVERIFY(!region1->retained);
+        QVERIFY(!region1->contentItem);
+        QTRY_VERIFY_WITH_TIMEOUT(content1.isNull(), 1000);
+        QTest::qWait(20);
+        UCTestExtras::touchRelease(0, bottomEdge, movePos);
+    }
+
+    void test_exited_region_released_without_budget()
+    {
+        qputenv("UC_BOTTOMEDGE_RETAINED_REGIONS", "0");
+        QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase("RetainedContent.qml"));
+        qunsetenv("UC_BOTTOMEDGE_RETAINED_REGIONS");
+        UCBottomEdge *bottomEdge = test->testItem();
+        UCBottomEdgePrivate *d = UCBottomEdgePrivate::get(bottomEdge);
+        UCBottomEdgeRegionPrivate *region1 = UCBottomEdgeRegionPrivate::get(d->regions[0]);
+        QCOMPARE(d->retainedRegionsBudget, 0);
+
+        QPoint movePos(bottomEdge->width() / 2.0f, bottomEdge->height() - 5);
+        UCTestExtras::touchPress(0, bottomEdge, movePos);
+        dragUpwards(bottomEdge, movePos, 0.4);
+        QCOMPARE(d->activeRegion, d->regions[0]);
+        QTRY_VERIFY_WITH_TIMEOUT(region1->contentItem != nullptr, 1000);
+        QPointer<QQuickItem> content1(region1->contentItem);
+
+        // the content is discarded on exit
+        dragUpwards(bottomEdge, movePos, 0.6);
+        QCOMPARE(d->activeRegion, d->regions[1]);
+        QVERIFY(d->retainedRegions.isEmpty());
+        QVERIFY(!region1->contentItem);
+        QTRY_VERIFY_WITH_TIMEOUT(content1.isNull(), 1000);
+        QTest::qWait(20);
+        UCTestExtras::touchRelease(0, bottomEdge, movePos);
+    }
+
     void test_action_triggered_commits()
     {
         QScopedPointer<BottomEdgeTestCase> test(new BottomEdgeTestCase("BottomEdgeWithAction.qml"));
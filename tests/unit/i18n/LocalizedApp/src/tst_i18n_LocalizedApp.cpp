@@ -192,6 +192,19 @@ private Q_SLOTS:
         // Sanity-check that the test strings would otherwise work and not no-op by accident
         QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Contar los gatitos"));
         QCOMPARE(i18n->ctr(QString("All Cats"), QString("All")), QString("Cada"));
+
+        // Repeated lookups are served from the cache
+        i18n->resetCacheStatistics();
+        QCOMPARE(i18n->tr(QString("Count the kilometres")), QString("Count the clicks"));
+        QCOMPARE(i18n->ctr(QString("All Calls"), QString("All")), QString("Todas"));
+        QCOMPARE(i18n->cacheHits(), quint64(2));
+        QCOMPARE(i18n->cacheMisses(), quint64(0));
+        // Changing the language drops the cached translations
+        i18n->setLanguage("C");
+        i18n->resetCacheStatistics();
+        QCOMPARE(i18n->tr(QString("Count the kittens")), QString("Count the kittens"));
+        QCOMPARE(i18n->cacheHits(), quint64(0));
+        QCOMPARE(i18n->cacheMisses(), quint64(1));
     }
 };
 
@@ -19,6 +19,7 @@
 namespace C {
 #include <libintl.h>
 }
+#include <time.h>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
@@ -37,6 +38,8 @@ namespace C {
 #include <UbuntuToolkit/ubuntutoolkitmodule.h>
 #include <UbuntuToolkit/private/ucunits_p.h>
 #include <UbuntuToolkit/private/i18n_p.h>
+#include <UbuntuToolkit/private/livetimer_p.h>
+#include <UbuntuToolkit/private/timeutils_p.h>
 
 UT_USE_NAMESPACE
 
@@ -102,6 +105,115 @@ private Q_SLOTS:
         delete view;
     }
 
+    void testCase_DateProximity_data()
+    {
+        QTest::addColumn<QDateTime>("time");
+        QTest::addColumn<int>("proximity");
+
+        QDateTime now(QDate(2016, 6, 15), QTime(12, 0));
+        QTest::newRow("now") << now.addSecs(20) << (int)DATE_PROXIMITY_NOW;
+        QTest::newRow("hour before") << now.addSecs(-59 * 60) << (int)DATE_PROXIMITY_HOUR;
+        QTest::newRow("hour after") << now.addSecs(59 * 60) << (int)DATE_PROXIMITY_HOUR;
+        QTest::newRow("today") << QDateTime(now.date(), QTime(0, 0)) << (int)DATE_PROXIMITY_TODAY;
+        QTest::newRow("end of today") << QDateTime(now.date(), QTime(23, 59, 59)) << (int)DATE_PROXIMITY_TODAY;
+        QTest::newRow("yesterday") << QDateTime(now.date().addDays(-1), QTime(23, 59)) << (int)DATE_PROXIMITY_YESTERDAY;
+        QTest::newRow("tomorrow") << QDateTime(now.date().addDays(1), QTime(0, 0)) << (int)DATE_PROXIMITY_TOMORROW;
+        QTest::newRow("last week") << QDateTime(now.date().addDays(-6), QTime(0, 0)) << (int)DATE_PROXIMITY_LAST_WEEK;
+        QTest::newRow("far back") << QDateTime(now.date().addDays(-7), QTime(23, 59)) << (int)DATE_PROXIMITY_FAR_BACK;
+        QTest::newRow("next week") << QDateTime(now.date().addDays(6), QTime(23, 59)) << (int)DATE_PROXIMITY_NEXT_WEEK;
+        QTest::newRow("far forward") << QDateTime(now.date().addDays(7), QTime(0, 0)) << (int)DATE_PROXIMITY_FAR_FORWARD;
+    }
+    void testCase_DateProximity()
+    {
+        QFETCH(QDateTime, time);
+        QFETCH(int, proximity);
+
+        QDateTime now(QDate(2016, 6, 15), QTime(12, 0));
+        DateProximity dateProximity(now);
+        QCOMPARE((int)dateProximity.proximity(time.toMSecsSinceEpoch()), proximity);
+        QCOMPARE((int)getDateProximity(now, time), proximity);
+    }
+
+    void testCase_RelativeLiveTimerTriggersOnProximityChange()
+    {
+        QDateTime now(QDate(2016, 6, 15), QTime(12, 0, 10));
+
+        LiveTimer relativeTimer;
+        QSignalSpy relativeSpy(&relativeTimer, SIGNAL(trigger()));
+        relativeTimer.setRelativeTime(now.addMSecs(-27500));
+        QVERIFY(!relativeTimer.updateRelativeProximity(DateProximity(now), false));
+        QCOMPARE(relativeSpy.count(), 0);
+
+        // a relative time with unchanged representation is not triggered
+        LiveTimer lastWeekTimer;
+        QSignalSpy lastWeekSpy(&lastWeekTimer, SIGNAL(trigger()));
+        lastWeekTimer.setRelativeTime(now.addDays(-3));
+        QVERIFY(!lastWeekTimer.updateRelativeProximity(DateProximity(now), false));
+
+        // still "now"
+        QVERIFY(!relativeTimer.updateRelativeProximity(DateProximity(now.addSecs(2)), false));
+        QCOMPARE(relativeSpy.count(), 0);
+
+        // leaves the "now" proximity
+        QVERIFY(relativeTimer.updateRelativeProximity(DateProximity(now.addSecs(3)), false));
+        QCOMPARE(relativeSpy.count(), 1);
+        QVERIFY(!lastWeekTimer.updateRelativeProximity(DateProximity(now.addSecs(3)), false));
+
+        // no further triggers within the same minute
+        QVERIFY(!relativeTimer.updateRelativeProximity(DateProximity(now.addSecs(4)), false));
+        QCOMPARE(relativeSpy.count(), 1);
+
+        // triggered on each minute boundary in the hour proximity
+        QVERIFY(!relativeTimer.updateRelativeProximity(DateProximity(now.addSecs(50)), true));
+        QCOMPARE(relativeSpy.count(), 2);
+        QVERIFY(!lastWeekTimer.updateRelativeProximity(DateProximity(now.addSecs(50)), true));
+        QCOMPARE(lastWeekSpy.count(), 0);
+    }
+
+    void testCase_RelativeDateTimeFollowsTimeZone()
+    {
+        UbuntuI18n* i18n = UbuntuI18n::instance();
+        i18n->setLanguage("C");
+        QByteArray timeZone = qgetenv("TZ");
+
+        // far back, so the proximity is the same in both time zones
+        qint64 time = QDateTime(QDate(2000, 1, 1), QTime(12, 0), Qt::UTC).toMSecsSinceEpoch();
+        qputenv("TZ", "UTC");
+        tzset();
+        DateProximity::invalidate();
+        QString utc = i18n->relativeDateTime(QDateTime::fromMSecsSinceEpoch(time));
+        QVERIFY2(utc.contains("12:00"), qPrintable(utc));
+
+        qputenv("TZ", "Asia/Kolkata");
+        tzset();
+        DateProximity::invalidate();
+        QString kolkata = i18n->relativeDateTime(QDateTime::fromMSecsSinceEpoch(time));
+
+        if (timeZone.isNull()) {
+            qunsetenv("TZ");
+        } else {
+            qputenv("TZ", timeZone);
+        }
+        tzset();
+        DateProximity::invalidate();
+        QVERIFY2(kolkata.contains("5:30"), qPrintable(kolkata));
+    }
+
+    void testCase_RelativeDateTimeFollowsOffset()
+    {
+        UbuntuI18n* i18n = UbuntuI18n::instance();
+        i18n->setLanguage("C");
+
+        // the same instant in two offsets is shown in each one's clock time
+        QDateTime time(QDate(2000, 1, 1), QTime(12, 0), Qt::UTC);
+        QString utc = i18n->relativeDateTime(time.toOffsetFromUtc(0));
+        QVERIFY2(utc.contains("12:00"), qPrintable(utc));
+        QString plusTwo = i18n->relativeDateTime(time.toOffsetFromUtc(2 * 3600));
+        QVERIFY2(plusTwo.contains("14:00"), qPrintable(plusTwo));
+        QString minusFive = i18n->relativeDateTime(time.toOffsetFromUtc(-5 * 3600));
+        QVERIFY2(minusFive.contains("07:00"), qPrintable(minusFive));
+    }
+
     void testCase_RelativeTime()
     {
         QQmlEngine engine;
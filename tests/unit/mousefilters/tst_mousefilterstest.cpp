@@ -1234,6 +1234,43 @@ private Q_SLOTS:
         UCTestExtras::touchRelease(2, overlayArea, guPoint(15, 15));
         QTest::waitForEvents();
     }
+
+    void testCase_inverseFiltersDispatchedPerWindow()
+    {
+        QScopedPointer<QQuickView> view(loadTest("FilterInverseTextInput.qml"));
+        QVERIFY(view);
+        QScopedPointer<QQuickView> otherView(loadTest("FilterInverseTextInput.qml"));
+        QVERIFY(otherView);
+        UCInverseMouse *filter = attachedFilter<UCInverseMouse>(view->rootObject(), "FilterOwner");
+        QVERIFY(filter);
+        UCMouseDispatcher *dispatcher = UCMouseDispatcher::forWindow(view.data());
+        QVERIFY(dispatcher);
+        UCMouseDispatcher *otherDispatcher = UCMouseDispatcher::forWindow(otherView.data());
+        QVERIFY(otherDispatcher);
+        QVERIFY(dispatcher != otherDispatcher);
+        QSignalSpy clicked(filter, SIGNAL(clicked(QQuickMouseEvent*, QQuickItem*)));
+
+        dispatcher->resetCounters();
+        otherDispatcher->resetCounters();
+        preventDblClick();
+        QTest::mouseClick(view.data(), Qt::LeftButton, 0, guPoint(10, 10));
+        QTest::waitForEvents();
+        QCOMPARE(clicked.count(), 1);
+        QVERIFY(dispatcher->dispatchedEvents() > 0);
+        QVERIFY(dispatcher->visitedFilters() > 0);
+        // the filters of the other window are not visited
+        QCOMPARE(otherDispatcher->dispatchedEvents(), quint64(0));
+        QCOMPARE(otherDispatcher->visitedFilters(), quint64(0));
+
+        // disabled filters are no longer dispatched to
+        filter->setEnabled(false);
+        dispatcher->resetCounters();
+        preventDblClick();
+        QTest::mouseClick(view.data(), Qt::LeftButton, 0, guPoint(10, 10));
+        QTest::waitForEvents();
+        QCOMPARE(clicked.count(), 1);
+        QCOMPARE(dispatcher->visitedFilters(), quint64(0));
+    }
 };
 
 QTEST_MAIN(tst_mouseFilterTest)
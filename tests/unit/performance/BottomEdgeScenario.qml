@@ -0,0 +1,51 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+MainView {
+    width: 240
+    height: 320
+    property alias bottomEdge: bottomEdge
+
+    Page {
+        anchors.fill: parent
+        header: PageHeader {
+            title: "BottomEdge"
+        }
+
+        BottomEdge {
+            id: bottomEdge
+            height: parent.height
+            hint.text: "Content"
+            contentComponent: Page {
+                width: bottomEdge.width
+                height: bottomEdge.height
+                header: PageHeader {
+                    title: "Content"
+                }
+                ListView {
+                    anchors.fill: parent
+                    model: 50
+                    delegate: ListItem {
+                        Label { text: "Item " + index }
+                    }
+                }
+            }
+        }
+    }
+}
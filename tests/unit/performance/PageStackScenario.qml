@@ -0,0 +1,55 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+MainView {
+    width: 240
+    height: 320
+
+    function pushPage() {
+        pageStack.push(pageComponent, {title: "Page " + pageStack.depth});
+    }
+    function popPage() {
+        pageStack.pop();
+    }
+    property alias depth: pageStack.depth
+
+    Component {
+        id: pageComponent
+        Page {
+            property alias title: pageHeader.title
+            header: PageHeader {
+                id: pageHeader
+            }
+            ListView {
+                anchors.fill: parent
+                model: 20
+                delegate: ListItem {
+                    ListItemLayout {
+                        title.text: "Item " + index
+                    }
+                }
+            }
+        }
+    }
+
+    PageStack {
+        id: pageStack
+        Component.onCompleted: pushPage()
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2016 Canonical Ltd.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; version 3.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+import QtQuick 2.4
+import Ubuntu.Components 1.3
+
+ListView {
+    width: 240
+    height: 320
+    model: 1000
+    delegate: ListItem {
+        objectName: "listItem" + index
+        leadingActions: ListItemActions {
+            actions: [
+                Action { iconName: "delete" }
+            ]
+        }
+        trailingActions: ListItemActions {
+            actions: [
+                Action { iconName: "edit" },
+                Action { iconName: "share" }
+            ]
+        }
+        ListItemLayout {
+            Icon { SlotsLayout.position: SlotsLayout.Leading; name: "contact"; width: units.gu(3) }
+            title.text: "Item " + index
+            subtitle.text: "subtitle"
+            summary.text: "summary"
+        }
+    }
+}
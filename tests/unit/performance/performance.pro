@@ -1,4 +1,5 @@
 include(../test-include.pri)
+QT += UbuntuMetrics
 SOURCES += tst_performance.cpp
 DEFINES += SRCDIR=\\\"$$PWD/\\\"
 
@@ -45,4 +46,7 @@ OTHER_FILES += \
     ListOfListItemLayout_complex2.qml \
     ListOfListItemLayout_labelsOnly.qml \
     ListOfScrollbars_1_3.qml \
-    ListOfScrollView_bothScrollbars_1_3.qml
+    ListOfScrollView_bothScrollbars_1_3.qml \
+    ScrollingListView13.qml \
+    BottomEdgeScenario.qml \
+    PageStackScenario.qml
@@ -15,11 +15,82 @@
  */
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QMutex>
 #include <QtCore/QString>
+#include <QtCore/qmath.h>
+#include <QtCore/private/qabstractanimation_p.h>
 #include <QtQml/QQmlEngine>
 #include <QtQuick/QQuickItem>
 #include <QtQuick/QQuickView>
+#include <QtQuick/private/qquickwindow_p.h>
 #include <QtTest/QtTest>
+#include <UbuntuMetrics/applicationmonitor.h>
+#include <cstdlib>
+#include <new>
+
+// Number of operator new calls, reported by the scenario benchmarks. Allocations
+// done with malloc (i.e. QArrayData) are not counted.
+static QAtomicInt operatorNewCount;
+
+void *operator new(std::size_t size)
+{
+    operatorNewCount.fetchAndAddRelaxed(1);
+    void *ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+// Collects the frame and input events logged by the application monitor.
+// Logging happens in a dedicated thread.
+class FrameLogger : public UMLogger
+{
+public:
+    void log(const UMEvent &event) Q_DECL_OVERRIDE
+    {
+        if (event.type == UMEvent::Frame) {
+            QMutexLocker lock(&m_mutex);
+            m_frames.append(event.frame);
+        } else if (event.type == UMEvent::Input) {
+            QMutexLocker lock(&m_mutex);
+            m_inputs.append(event.input);
+        }
+    }
+    bool isOpen() Q_DECL_OVERRIDE
+    {
+        return true;
+    }
+
+    int count()
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_frames.count();
+    }
+    QVector<UMFrameEvent> takeFrames()
+    {
+        QMutexLocker lock(&m_mutex);
+        QVector<UMFrameEvent> frames;
+        frames.swap(m_frames);
+        return frames;
+    }
+    QVector<UMInputEvent> takeInputs()
+    {
+        QMutexLocker lock(&m_mutex);
+        QVector<UMInputEvent> inputs;
+        inputs.swap(m_inputs);
+        return inputs;
+    }
+
+private:
+    QMutex m_mutex;
+    QVector<UMFrameEvent> m_frames;
+    QVector<UMInputEvent> m_inputs;
+};
 
 class tst_Performance : public QObject
 {
@@ -31,6 +102,7 @@ public:
 private:
     QQuickView *quickView;
     QQmlEngine *quickEngine;
+    FrameLogger *frameLogger;
 
     QQuickItem *loadDocument(const QString &document)
     {
@@ -40,6 +112,91 @@ private:
         return quickView->rootObject();
     }
 
+    // Shows the document with animations driven by a fixed 16ms step, so
+    // scenarios play the same number of frames on every machine. Frames are
+    // logged till finishScenario() only, so the other benchmarks don't pay for
+    // the monitoring.
+    QQuickItem *startScenario(const QString &document)
+    {
+        QQuickItem *root = loadDocument(document);
+        if (!root) {
+            return root;
+        }
+        UMApplicationMonitor::instance()->setLogging(true);
+        QUnifiedTimer::instance()->setConsistentTiming(true);
+        quickView->show();
+        QTest::qWaitForWindowExposed(quickView);
+        settle();
+        frameLogger->takeFrames();
+        operatorNewCount.store(0);
+        return root;
+    }
+
+    // Waits till no more frames are rendered, e.g. animations are over.
+    void settle()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        int frames = -1;
+        while (frames != frameLogger->count() && timer.elapsed() < 5000) {
+            frames = frameLogger->count();
+            QTest::qWait(50);
+        }
+    }
+
+    static qreal percentile(QVector<qreal> values, int percent)
+    {
+        std::sort(values.begin(), values.end());
+        int index = qMax(0, qCeil(percent * values.count() / 100.0) - 1);
+        return values[index];
+    }
+
+    static QString percentiles(const QVector<qreal> &values)
+    {
+        return QStringLiteral("50% %1, 90% %2, 95% %3, 99% %4")
+            .arg(percentile(values, 50), 0, 'f', 2).arg(percentile(values, 90), 0, 'f', 2)
+            .arg(percentile(values, 95), 0, 'f', 2).arg(percentile(values, 99), 0, 'f', 2);
+    }
+
+    // Reports the percentiles of the CPU time spent per frame by the scene
+    // graph (synchronization and render passes) and of the time between
+    // swaps. The 95th percentile of the former is the benchmark result.
+    void finishScenario(QQuickItem *root)
+    {
+        settle();
+        const int operatorNewCalls = operatorNewCount.load();
+        UMApplicationMonitor::instance()->setLogging(false);
+        const QVector<UMFrameEvent> frames = frameLogger->takeFrames();
+        QUnifiedTimer::instance()->setConsistentTiming(false);
+        quickView->hide();
+        delete root;
+
+        if (frames.isEmpty()) {
+            QSKIP("No frame rendered, scenario benchmarks need an OpenGL capable platform");
+        }
+        QVector<qreal> frameTimes;
+        QVector<qreal> deltaTimes;
+        Q_FOREACH(const UMFrameEvent &frame, frames) {
+            frameTimes.append((frame.syncTime + frame.renderTime) / 1000000.0);
+            deltaTimes.append(frame.deltaTime / 1000000.0);
+        }
+        QTest::qWarn(qPrintable(QStringLiteral("%1 frames, %2 operator new calls")
+                                .arg(frames.count()).arg(operatorNewCalls)));
+        QTest::qWarn(qPrintable(QStringLiteral("frame time (ms): ") + percentiles(frameTimes)));
+        QTest::qWarn(qPrintable(QStringLiteral("time between swaps (ms): ") + percentiles(deltaTimes)));
+        QTest::setBenchmarkResult(percentile(frameTimes, 95), QTest::WalltimeMilliseconds);
+    }
+
+    void swipe(const QPoint &from, int dx)
+    {
+        const int steps = 10;
+        QTest::mousePress(quickView, Qt::LeftButton, 0, from);
+        for (int i = 1; i <= steps; i++) {
+            QTest::mouseMove(quickView, from + QPoint(dx * i / steps, 0), 16);
+        }
+        QTest::mouseRelease(quickView, Qt::LeftButton, 0, from + QPoint(dx, 0), 16);
+    }
+
 private Q_SLOTS:
 
     void initTestCase()
@@ -55,10 +212,18 @@ private Q_SLOTS:
         QStringList imports = quickEngine->importPathList();
         imports.prepend(QDir(modules).absolutePath());
         quickEngine->setImportPathList(imports);
+
+        // logging is enabled by the scenarios
+        frameLogger = new FrameLogger;
+        UMApplicationMonitor *monitor = UMApplicationMonitor::instance();
+        monitor->setLoggingFilter(UMApplicationMonitor::FrameEvent | UMApplicationMonitor::InputEvent);
+        monitor->installLogger(frameLogger);
     }
 
     void cleanupTestCase()
     {
+        UMApplicationMonitor *monitor = UMApplicationMonitor::instance();
+        monitor->removeLogger(frameLogger);
         delete quickView;
     }
 
@@ -151,6 +316,165 @@ private Q_SLOTS:
             delete root;
     }
 
+    void benchmark_relayout_data()
+    {
+        QTest::addColumn<QString>("document");
+
+        QTest::newRow("list with new ListItem (no actions) and ListItemLayout with 2 defined labels and 3 slots") << "ListOfListItemLayout_complex1.qml";
+        QTest::newRow("list with new ListItem (inline actions!) and ListItemLayout with 3 labels and 3 slots") << "ListOfListItemLayout_complex2.qml";
+    }
+
+    void benchmark_relayout()
+    {
+        QFETCH(QString, document);
+
+        QQuickItem *root = loadDocument(document);
+        QVERIFY(root);
+        QQuickWindowPrivate *window = QQuickWindowPrivate::get(quickView);
+        const qreal initialWidth = root->width();
+        bool shrink = true;
+        QBENCHMARK {
+            // resizing the list relayouts every item in it; polishing the items
+            // is what the render loop would do before rendering the next frame
+            root->setWidth(shrink ? initialWidth / 2 : initialWidth);
+            window->polishItems();
+            shrink = !shrink;
+        }
+        delete root;
+    }
+
+    void benchmark_scrolling_data()
+    {
+        QTest::addColumn<int>("seconds");
+
+        QTest::newRow("flick ListView of ListItem 1.3 for 5 seconds") << 5;
+    }
+
+    void benchmark_scrolling()
+    {
+        QFETCH(int, seconds);
+
+        QQuickItem *root = startScenario("ScrollingListView13.qml");
+        QVERIFY(root);
+        // frames are played at a fixed 60 fps animation step
+        QElapsedTimer timer;
+        timer.start();
+        qreal velocity = -4000;
+        while (frameLogger->count() < seconds * 60 && timer.elapsed() < seconds * 10000) {
+            if (!root->property("moving").toBool()) {
+                if (root->property("atYEnd").toBool()) {
+                    velocity = 4000;
+                } else if (root->property("atYBeginning").toBool()) {
+                    velocity = -4000;
+                }
+                QVERIFY(QMetaObject::invokeMethod(root, "flick", Q_ARG(qreal, 0), Q_ARG(qreal, velocity)));
+            }
+            QTest::qWait(16);
+        }
+        finishScenario(root);
+    }
+
+    void benchmark_swipe_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("swipe ListItem 1.3 leading and trailing actions in and out") << 10;
+    }
+
+    void benchmark_swipe()
+    {
+        QFETCH(int, count);
+
+        QQuickItem *root = startScenario("ScrollingListView13.qml");
+        QVERIFY(root);
+        const int x = quickView->width() / 2;
+        const int dx = quickView->width() / 3;
+        for (int i = 0; i < count; i++) {
+            // swipe one of the first visible list items in and back out
+            const QPoint row(x, 28 + (i % 5) * 56);
+            const int direction = (i % 2) ? -1 : 1;
+            swipe(row, direction * dx);
+            settle();
+            swipe(row + QPoint(direction * dx, 0), -direction * dx);
+            settle();
+        }
+        finishScenario(root);
+    }
+
+    void benchmark_bottomEdge_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("commit and collapse BottomEdge") << 10;
+    }
+
+    void benchmark_bottomEdge()
+    {
+        QFETCH(int, count);
+
+        QQuickItem *root = startScenario("BottomEdgeScenario.qml");
+        QVERIFY(root);
+        QObject *bottomEdge = root->property("bottomEdge").value<QObject*>();
+        QVERIFY(bottomEdge);
+        for (int i = 0; i < count; i++) {
+            QVERIFY(QMetaObject::invokeMethod(bottomEdge, "commit"));
+            settle();
+            QVERIFY(QMetaObject::invokeMethod(bottomEdge, "collapse"));
+            settle();
+        }
+        finishScenario(root);
+    }
+
+    void benchmark_pageStack_data()
+    {
+        QTest::addColumn<int>("count");
+
+        QTest::newRow("push and pop Page on PageStack") << 10;
+    }
+
+    void benchmark_pageStack()
+    {
+        QFETCH(int, count);
+
+        QQuickItem *root = startScenario("PageStackScenario.qml");
+        QVERIFY(root);
+        for (int i = 0; i < count; i++) {
+            QVERIFY(QMetaObject::invokeMethod(root, "pushPage"));
+            settle();
+            QCOMPARE(root->property("depth").toInt(), 2);
+            QVERIFY(QMetaObject::invokeMethod(root, "popPage"));
+            settle();
+        }
+        finishScenario(root);
+    }
+
+    // Input causing no frame, like a hover move over static items, must not be
+    // reported as the latency of a frame rendered later for another reason.
+    void test_idle_input_not_reported()
+    {
+        QQuickItem *root = startScenario("RectangleGrid.qml");
+        QVERIFY(root);
+        frameLogger->takeInputs();
+        QTest::mouseMove(quickView, QPoint(10, 10));
+        QTest::qWait(1000);
+        quickView->update();
+        settle();
+        UMApplicationMonitor::instance()->setLogging(false);
+        const QVector<UMFrameEvent> frames = frameLogger->takeFrames();
+        const QVector<UMInputEvent> inputs = frameLogger->takeInputs();
+        QUnifiedTimer::instance()->setConsistentTiming(false);
+        quickView->hide();
+        delete root;
+
+        if (frames.isEmpty()) {
+            QSKIP("No frame rendered, input latencies need an OpenGL capable platform");
+        }
+        Q_FOREACH(const UMInputEvent &input, inputs) {
+            QVERIFY2(input.swapLatency < 500000000,
+                     qPrintable(QStringLiteral("%1 ns").arg(input.swapLatency)));
+        }
+    }
+
     void benchmark_import_data()
     {
         QTest::addColumn<QString>("document");
@@ -16,6 +16,9 @@
 
 #include <QtCore/QDebug>
 #include <QtCore/QString>
+#include <QtDBus/QDBusConnection>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusObjectPath>
 #include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 #include <UbuntuToolkit/private/ucserviceproperties_p_p.h>
@@ -24,6 +27,66 @@
 
 UT_USE_NAMESPACE
 
+static const char mockService[] = "com.ubuntu.test.Accounts";
+static const char mockAccountsPath[] = "/com/ubuntu/test/Accounts";
+static const char mockUserPath[] = "/com/ubuntu/test/Accounts/User";
+
+// service registered on the session bus, which is private to the tests run
+// by dbus-test-runner
+class MockAccounts : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.ubuntu.test.Accounts")
+public Q_SLOTS:
+    QDBusObjectPath FindUserById(qlonglong)
+    {
+        return QDBusObjectPath(mockUserPath);
+    }
+};
+
+class MockSound : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.ubuntu.test.Sound")
+    Q_PROPERTY(bool IncomingCallVibrate READ incomingCallVibrate WRITE setIncomingCallVibrate)
+    Q_PROPERTY(QString Ringtone READ ringtone WRITE setRingtone)
+public:
+    MockSound() : m_incomingCallVibrate(true), m_ringtone("ring.ogg") {}
+
+    bool incomingCallVibrate() const
+    {
+        return m_incomingCallVibrate;
+    }
+    void setIncomingCallVibrate(bool value)
+    {
+        m_incomingCallVibrate = value;
+        notify("IncomingCallVibrate", value);
+    }
+    QString ringtone() const
+    {
+        return m_ringtone;
+    }
+    void setRingtone(const QString &value)
+    {
+        m_ringtone = value;
+        notify("Ringtone", value);
+    }
+
+    void notify(const QString &property, const QVariant &value)
+    {
+        QDBusMessage signal = QDBusMessage::createSignal(mockUserPath,
+            "org.freedesktop.DBus.Properties", "PropertiesChanged");
+        QVariantMap changed;
+        changed.insert(property, value);
+        signal << QString("com.ubuntu.test.Sound") << changed << QStringList();
+        QDBusConnection::sessionBus().send(signal);
+    }
+
+private:
+    bool m_incomingCallVibrate;
+    QString m_ringtone;
+};
+
 class tst_ServiceProperties : public QObject
 {
     Q_OBJECT
@@ -34,6 +97,9 @@ public:
 private:
 
     QString error;
+    QString sessionBusError;
+    QScopedPointer<MockAccounts> mockAccounts;
+    QScopedPointer<MockSound> mockSound;
 
     // FIXME use UbuntuTestCase::ignoreWaring in Vivid
     void ignoreWarning(const QString& fileName, uint line, uint column, const QString& message, uint occurences=1)
@@ -62,6 +128,28 @@ private Q_SLOTS:
         if (watcher->status() == UCServiceProperties::ConnectionError) {
             error = "Skip test: " + watcher->error();
         }
+
+        // mock services used by the session bus tests
+        QDBusConnection bus = QDBusConnection::sessionBus();
+        if (!bus.isConnected()) {
+            sessionBusError = "Skip test: no session bus";
+            return;
+        }
+        mockAccounts.reset(new MockAccounts);
+        mockSound.reset(new MockSound);
+        QVERIFY(bus.registerObject(mockAccountsPath, mockAccounts.data(), QDBusConnection::ExportAllSlots));
+        QVERIFY(bus.registerObject(mockUserPath, mockSound.data(), QDBusConnection::ExportAllProperties));
+        QVERIFY(bus.registerService(mockService));
+    }
+
+    void cleanupTestCase()
+    {
+        QDBusConnection bus = QDBusConnection::sessionBus();
+        if (mockAccounts) {
+            bus.unregisterObject(mockAccountsPath);
+            bus.unregisterObject(mockUserPath);
+            bus.unregisterService(mockService);
+        }
     }
 
     void cleanup()
@@ -70,6 +158,49 @@ private Q_SLOTS:
         qputenv("SHOW_SERVICEPROPERTIES_WARNINGS", QByteArray());
     }
 
+    void test_session_bus_synchronization()
+    {
+        if (!sessionBusError.isEmpty()) {
+            QSKIP(qPrintable(sessionBusError));
+        }
+        mockSound->setIncomingCallVibrate(true);
+        mockSound->setRingtone("ring.ogg");
+
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SessionBusWatcher.qml"));
+        UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+        // all properties are fetched at once
+        QCOMPARE(watcher->property("incomingCallVibrate").toBool(), true);
+        QCOMPARE(watcher->property("ringtone").toString(), QString("ring.ogg"));
+        // the property not provided by the service is reported
+        QCOMPARE(watcher->property("error").toString(), QString("No such property 'MissingProperty'"));
+    }
+
+    void test_session_bus_property_changes()
+    {
+        if (!sessionBusError.isEmpty()) {
+            QSKIP(qPrintable(sessionBusError));
+        }
+        mockSound->setIncomingCallVibrate(true);
+        mockSound->setRingtone("ring.ogg");
+
+        QScopedPointer<UbuntuTestCase> test(new UbuntuTestCase("SessionBusWatcher.qml"));
+        UCServiceProperties *watcher = static_cast<UCServiceProperties*>(test->rootObject()->property("service").value<QObject*>());
+        QVERIFY(watcher);
+        QTRY_COMPARE(watcher->status(), UCServiceProperties::Active);
+
+        // the changed values are applied from the signal
+        mockSound->setRingtone("alarm.ogg");
+        QTRY_COMPARE(watcher->property("ringtone").toString(), QString("alarm.ogg"));
+
+        // and so are the values set through the service
+        UCServicePropertiesPrivate *pWatcher = UCServicePropertiesPrivate::get(watcher);
+        QVERIFY(pWatcher->testProperty("IncomingCallVibrate", false));
+        QCOMPARE(mockSound->incomingCallVibrate(), false);
+        QTRY_COMPARE(watcher->property("incomingCallVibrate").toBool(), false);
+    }
+
     void test_change_property()
     {
         if (!error.isEmpty()) {
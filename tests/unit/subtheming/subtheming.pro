@@ -48,6 +48,7 @@ OTHER_FILES += \
     DefaultTheme.qml \
     themes/DerivedTheme/parent_theme \
     themes/DerivedTheme/1.2/TestStyle.qml \
-    themes/DerivedTheme/1.3/Palette.qml
+    themes/DerivedTheme/1.3/Palette.qml \
+    ThemeSwitch.qml
 
 
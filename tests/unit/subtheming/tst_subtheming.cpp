@@ -791,6 +791,68 @@ private Q_SLOTS:
         QVERIFY(button->findChild<QQuickItem*>("TestStyle"));
     }
 
+    void test_unchanged_theme_styles_kept_on_theme_switch()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("ThemeSwitch.qml"));
+        UCStyledItemBase *button = view->findItem<UCStyledItemBase*>("TestButton");
+        UCStyledItemBase *selector = view->findItem<UCStyledItemBase*>("TestSelector");
+        UCTheme *theme = button->getTheme();
+        QVERIFY(theme);
+        QQuickItem *buttonStyle = UCStyledItemBasePrivate::get(button)->styleInstance();
+        QQuickItem *selectorStyle = UCStyledItemBasePrivate::get(selector)->styleInstance();
+        QVERIFY(buttonStyle);
+        QVERIFY(selectorStyle);
+        QObject *palette = theme->palette();
+        QVERIFY(palette);
+
+        // SuruDark inherits ButtonStyle from Ambiance but has its own OptionSelectorStyle
+        QSignalSpy themeSpy(button, SIGNAL(themeChanged()));
+        theme->setName("Ubuntu.Components.Themes.SuruDark");
+        QCOMPARE(themeSpy.count(), 1);
+        QCOMPARE(UCStyledItemBasePrivate::get(button)->styleInstance(), buttonStyle);
+        QVERIFY(UCStyledItemBasePrivate::get(selector)->styleInstance() != selectorStyle);
+        QVERIFY(theme->palette() != palette);
+
+        // switching back reuses the palette of the Ambiance snapshot
+        theme->setName("Ubuntu.Components.Themes.Ambiance");
+        QCOMPARE(theme->palette(), palette);
+        QCOMPARE(UCStyledItemBasePrivate::get(button)->styleInstance(), buttonStyle);
+    }
+
+    void test_theme_snapshot_dropped_on_search_path_change()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("ThemeSwitch.qml"));
+        UCStyledItemBase *button = view->findItem<UCStyledItemBase*>("TestButton");
+        UCTheme *theme = button->getTheme();
+        QVERIFY(theme);
+        QPointer<QObject> palette = theme->palette();
+        QVERIFY(palette);
+
+        theme->setName("Ubuntu.Components.Themes.SuruDark");
+        // the test themes folder is added to the search path
+        qputenv("UBUNTU_UI_TOOLKIT_THEMES_PATH", QString(m_themesPath + ":./themes").toLocal8Bit());
+        theme->setName("Ubuntu.Components.Themes.Ambiance");
+        QVERIFY(theme->palette());
+        QVERIFY(palette.isNull());
+    }
+
+    void test_theme_snapshot_keyed_by_palette_version()
+    {
+        QScopedPointer<ThemeTestCase> view(new ThemeTestCase("ThemeSwitch.qml"));
+        UCStyledItemBase *button = view->findItem<UCStyledItemBase*>("TestButton");
+        UCTheme *theme = button->getTheme();
+        QVERIFY(theme);
+        QObject *palette = theme->palette();
+        QVERIFY(palette);
+
+        theme->setName("Ubuntu.Components.Themes.SuruDark");
+        // the palette of another version is not reused
+        UCTheme::previousVersion = BUILD_VERSION(1, 2);
+        theme->setName("Ubuntu.Components.Themes.Ambiance");
+        QVERIFY(theme->palette());
+        QVERIFY(theme->palette() != palette);
+    }
+
     void test_style_reset_to_theme_style()
     {
         QScopedPointer<ThemeTestCase> view(new ThemeTestCase("StyleKept.qml"));
@@ -125,6 +125,8 @@ private Q_SLOTS:
     void makoLeftEdgeDrag_movesSlightlyBackwardsOnStart();
     void grabGesture();
     void grabGestureWithImmediateRecognition();
+    void touchResamplerPrediction();
+    void resampledTouchPosition();
 
 private:
     // QTest::touchEvent takes QPoint instead of QPointF and I don't want to
@@ -1445,6 +1447,69 @@ void tst_UCSwipeArea::grabGestureWithImmediateRecognition()
     sendTouchRelease(timestamp, 0, touchPoint);
 }
 
+void tst_UCSwipeArea::touchResamplerPrediction()
+{
+    TouchResampler resampler;
+    resampler.setMaxPrediction(16);
+    QVERIFY(resampler.isEmpty());
+
+    resampler.addSample(QPointF(0., 0.), 0);
+    QCOMPARE(resampler.velocity(), QPointF());
+    resampler.addSample(QPointF(10., 5.), 10);
+    resampler.addSample(QPointF(20., 10.), 20);
+
+    // NB: qFuzzyCompare(), used internally by QCOMPARE(), is broken.
+    QVERIFY(qAbs(resampler.velocity().x() - 1.) < 0.001);
+    QVERIFY(qAbs(resampler.velocity().y() - 0.5) < 0.001);
+
+    // interpolated between two samples
+    QCOMPARE(resampler.positionAt(15), QPointF(15., 7.5));
+    // extrapolated past the last sample
+    QVERIFY(resampler.isPredicting(28));
+    QCOMPARE(resampler.positionAt(28), QPointF(28., 14.));
+    // but not further than the max prediction
+    QVERIFY(!resampler.isPredicting(100));
+    QCOMPARE(resampler.positionAt(100), QPointF(36., 18.));
+
+    resampler.reset();
+    QVERIFY(resampler.isEmpty());
+    QCOMPARE(resampler.lastSampleTime(), qint64(-1));
+}
+
+/*
+  Checks that with resampling enabled the touch position is published on the next
+  frame rather than on each touch event.
+ */
+void tst_UCSwipeArea::resampledTouchPosition()
+{
+    UCSwipeArea *edgeDragArea =
+        m_view->rootObject()->findChild<UCSwipeArea*>("hnDragArea");
+    QVERIFY(edgeDragArea != 0);
+    UCSwipeAreaPrivate *d = UCSwipeAreaPrivate::get(edgeDragArea);
+    d->setRecognitionTimer(m_fakeTimerFactory->createTimer(edgeDragArea));
+    d->setTimeSource(m_fakeTimerFactory->timeSource());
+    d->setResampling(true);
+    edgeDragArea->setImmediateRecognition(true);
+
+    QPointF touchScenePosition(m_view->width() - (edgeDragArea->width()/2.0f), m_view->height()/2.0f);
+
+    sendTouchPress(0 /* timestamp */, 0 /* id */, touchScenePosition);
+
+    QSignalSpy touchSpy(edgeDragArea, &UCSwipeArea::touchPositionChanged);
+
+    touchScenePosition.rx() = m_view->width() / 2;
+    sendTouchUpdate(50 /* timestamp */, 0 /* id */, touchScenePosition);
+    QCOMPARE(touchSpy.count(), 0);
+
+    Q_EMIT m_view->afterAnimating();
+    QCOMPARE(touchSpy.count(), 1);
+    QCOMPARE(edgeDragArea->touchPosition().x(), touchScenePosition.x() - edgeDragArea->x());
+
+    sendTouchRelease(60 /* timestamp */, 0 /* id */, touchScenePosition);
+    QVERIFY(d->touchResampler.isEmpty());
+    d->setResampling(false);
+}
+
 QTEST_MAIN(tst_UCSwipeArea)
 
 #include "tst_swipearea.moc"
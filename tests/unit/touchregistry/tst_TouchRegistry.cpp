@@ -18,6 +18,7 @@
 #include <QtGui/QTouchEvent>
 #include <QtQuick/QQuickItem>
 #include <QtTest/QtTest>
+#include <UbuntuGestures/private/pool_p.h>
 #include <UbuntuGestures/private/timer_p.h>
 #include <UbuntuGestures/private/touchownershipevent_p.h>
 #include <UbuntuGestures/private/touchregistry_p.h>
@@ -34,6 +35,13 @@ public:
     bool containsTouchWithId(int touchId) const;
 };
 
+struct PoolItem {
+    PoolItem() : id(-1) {}
+    bool isValid() const { return id >= 0; }
+    void reset() { id = -1; }
+    int id;
+};
+
 class DummyCandidate : public QQuickItem
 {
     Q_OBJECT
@@ -73,6 +81,10 @@ private Q_SLOTS:
     void interimOwnerWontGetUnownedTouchEvents();
     void candidateVanishes();
     void candicateOwnershipReentrace();
+    void poolReusesFreedSlots();
+    void poolFreeSlotWhileIterating();
+    void benchmarkPool_data();
+    void benchmarkPool();
 
 private:
     TouchRegistry *touchRegistry;
@@ -920,6 +932,105 @@ void tst_TouchRegistry::candicateOwnershipReentrace()
     QCOMPARE(candicate3.lostTouches.count(), 1);
 }
 
+void tst_TouchRegistry::poolReusesFreedSlots()
+{
+    Pool<PoolItem> pool;
+    QVERIFY(pool.isEmpty());
+
+    PoolItem *first = &pool.getEmptySlot();
+    first->id = 0;
+    pool.getEmptySlot().id = 1;
+    QCOMPARE(pool.count(), 2);
+
+    Pool<PoolItem>::Iterator found;
+    pool.forEach([&](Pool<PoolItem>::Iterator &item) {
+        if (item->id == 0) {
+            found = item;
+            return false;
+        }
+        return true;
+    });
+    QVERIFY(found);
+    pool.freeSlot(found);
+    QCOMPARE(pool.count(), 1);
+
+    // the vacancy is handed out again instead of growing the pool
+    PoolItem *reused = &pool.getEmptySlot();
+    QCOMPARE(reused, first);
+    reused->id = 2;
+
+    QSet<int> ids;
+    pool.forEach([&](Pool<PoolItem>::Iterator &item) {
+        ids.insert(item->id);
+        return true;
+    });
+    QCOMPARE(ids, QSet<int>() << 1 << 2);
+}
+
+void tst_TouchRegistry::poolFreeSlotWhileIterating()
+{
+    Pool<PoolItem> pool;
+    for (int i = 0; i < 10; ++i) {
+        pool.getEmptySlot().id = i;
+    }
+
+    int visited = 0;
+    pool.forEach([&](Pool<PoolItem>::Iterator &item) {
+        ++visited;
+        if (item->id % 2 == 0) {
+            pool.freeSlot(item);
+        }
+        return true;
+    });
+    QCOMPARE(visited, 10);
+    QCOMPARE(pool.count(), 5);
+
+    QSet<int> ids;
+    pool.forEach([&](Pool<PoolItem>::Iterator &item) {
+        ids.insert(item->id);
+        return true;
+    });
+    QCOMPARE(ids, QSet<int>() << 1 << 3 << 5 << 7 << 9);
+
+    pool.forEach([&](Pool<PoolItem>::Iterator &item) {
+        pool.freeSlot(item);
+        return true;
+    });
+    QVERIFY(pool.isEmpty());
+}
+
+void tst_TouchRegistry::benchmarkPool_data()
+{
+    QTest::addColumn<int>("liveItems");
+
+    QTest::newRow("10 fingers") << 10;
+    QTest::newRow("1000 items") << 1000;
+}
+
+void tst_TouchRegistry::benchmarkPool()
+{
+    QFETCH(int, liveItems);
+
+    Pool<PoolItem> pool;
+    for (int i = 0; i < liveItems; ++i) {
+        pool.getEmptySlot().id = i;
+    }
+
+    // churn one item at a time, the pattern of a touch being pressed and released
+    int nextId = liveItems;
+    QBENCHMARK {
+        pool.forEach([&](Pool<PoolItem>::Iterator &item) {
+            if (item->id == nextId - liveItems) {
+                pool.freeSlot(item);
+                return false;
+            }
+            return true;
+        });
+        pool.getEmptySlot().id = nextId++;
+    }
+    QCOMPARE(pool.count(), liveItems);
+}
+
 ////////////// TouchMemento //////////
 
 TouchMemento::TouchMemento(const QTouchEvent *touchEvent)
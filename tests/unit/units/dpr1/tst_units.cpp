@@ -17,6 +17,9 @@
  */
 
 #include <QtTest/QtTest>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlContext>
+#include <QtQml/QQmlEngine>
 #include <UbuntuToolkit/private/ucunits_p.h>
 
 UT_USE_NAMESPACE
@@ -72,6 +75,28 @@ private Q_SLOTS:
         QCOMPARE(units.gu(0.9999), 8.0f);
         QCOMPARE(units.gu(1000.01), 8000.0f);
     }
+    void bindingsFollowGridUnit() {
+        QQmlEngine engine;
+        UCUnits *units = new UCUnits(&engine);
+        engine.rootContext()->setContextProperty("units", units);
+
+        QQmlComponent component(&engine);
+        component.setData("import QtQml 2.0\n"
+                          "QtObject {\n"
+                          "    property real guValue: units.gu(2)\n"
+                          "    property real dpValue: units.dp(10)\n"
+                          "}", QUrl());
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY(object);
+        QCOMPARE(object->property("guValue").toReal(), 16.0);
+        QCOMPARE(object->property("dpValue").toReal(), 10.0);
+
+        // the context property is not reset, the bindings track the grid unit
+        units->setGridUnit(16);
+        QCOMPARE(object->property("guValue").toReal(), 32.0);
+        QCOMPARE(object->property("dpValue").toReal(), 20.0);
+    }
+
     void dpGridUnitTen() {
         UCUnits units;
         units.setGridUnit(10);
@@ -67,6 +67,20 @@ private Q_SLOTS:
         QCOMPARE(units.gu(100000), 2000000.0f);
         QCOMPARE(units.gu(150.51983), 3010.0f);
     }
+
+    void gridUnitChangedOnceForScaleChanges() {
+        UCUnits units;
+        QSignalSpy spy(&units, SIGNAL(gridUnitChanged()));
+
+        QMetaObject::invokeMethod(qGuiApp->platformNativeInterface(), "changeScale", Q_ARG(float, 2.5));
+        QMetaObject::invokeMethod(qGuiApp->platformNativeInterface(), "changeScale", Q_ARG(float, 3.0));
+        // the new value is used right away, the change is announced once
+        QCOMPARE(units.gu(1), 24.0f);
+        QCOMPARE(spy.count(), 0);
+        QTRY_COMPARE(spy.count(), 1);
+        QTest::qWait(50);
+        QCOMPARE(spy.count(), 1);
+    }
 };
 
 QTEST_MAIN(tst_UCUnitsScale)
@@ -43,6 +43,14 @@ Item {
         }
     }
 
+    Component {
+        id: boldLabel
+        Label {
+            text: "Hello Dolly!"
+            font.bold: true
+        }
+    }
+
     Component {
         id: labelModel
         ListView {
@@ -94,6 +102,24 @@ Item {
             verify(test.color != theme.palette.normal.backgroundText);
         }
 
+        function test_default_font_follows_text_size() {
+            var test = loadTest(testLabel);
+            var mediumSize = test.font.pixelSize;
+            test.textSize = Label.Large;
+            verify(test.font.pixelSize > mediumSize);
+            compare(test.font.family, "Ubuntu");
+            compare(test.font.weight, Font.Light);
+        }
+
+        function test_custom_font_kept_on_text_size_change() {
+            var test = loadTest(boldLabel);
+            var mediumSize = test.font.pixelSize;
+            test.textSize = Label.Small;
+            verify(test.font.pixelSize < mediumSize);
+            compare(test.font.bold, true);
+            compare(test.font.family, "Ubuntu");
+        }
+
         function test_label_destruction_crash_bug1560044() {
             var test = loadTest(labelModel);
             testLoader.sourceComponent = null;
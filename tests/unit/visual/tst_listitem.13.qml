@@ -73,6 +73,13 @@ Item {
         Component.onCompleted: reset()
     }
 
+    Component {
+        id: releasedItemComponent
+        ListItem {
+            leadingActions: leading
+        }
+    }
+
     Component {
         id: customDelegate
         Rectangle {
@@ -813,6 +820,50 @@ Item {
             listView.ViewItems.selectedIndices = [];
         }
 
+        function test_select_range_and_all() {
+            listView.positionViewAtBeginning();
+            listView.ViewItems.selectedIndices = [5, 1];
+            compare(listView.ViewItems.selectedIndices, [1, 5], "Selected indices are not sorted");
+            listView.ViewItems.selectRange(2, 3);
+            compare(listView.ViewItems.selectedIndices, [1, 2, 3, 5], "Range not selected");
+            compare(findChild(listView, "listItem2").selected, true, "ListItem at index 2 is not selected!");
+
+            selectedIndicesSpy.clear();
+            listView.ViewItems.selectAll();
+            compare(listView.ViewItems.selectedIndices.length, listView.count, "Not all items selected");
+            listView.ViewItems.clearSelection();
+            // ranges are clamped to the items of the view
+            listView.ViewItems.selectRange(listView.count - 2, 100000);
+            compare(listView.ViewItems.selectedIndices, [listView.count - 2, listView.count - 1], "Range not clamped");
+            listView.ViewItems.selectRange(-10, 2147483647);
+            compare(listView.ViewItems.selectedIndices.length, listView.count, "Range not clamped");
+            listView.ViewItems.clearSelection();
+            listView.ViewItems.selectAll();
+            // changes within the same event loop iteration are notified once
+            selectedIndicesSpy.wait();
+            compare(selectedIndicesSpy.count, 1, "Selection changes not coalesced");
+            listView.ViewItems.clearSelection();
+            compare(listView.ViewItems.selectedIndices.length, 0, "Selection not cleared");
+        }
+
+        function test_selection_follows_model_changes() {
+            objectModel.reset();
+            listView.ViewItems.selectedIndices = [1, 2, 5];
+            objectModel.insert(2, {data: 100});
+            compare(listView.ViewItems.selectedIndices, [1, 3, 6], "Selection not shifted on insert");
+            objectModel.insert(0, {data: 101});
+            compare(listView.ViewItems.selectedIndices, [2, 4, 7], "Selection not shifted on insert at front");
+            // removing a selected row drops it from the selection
+            objectModel.remove(4, 1);
+            compare(listView.ViewItems.selectedIndices, [2, 6], "Selection not shifted on remove");
+            objectModel.remove(0, 1);
+            compare(listView.ViewItems.selectedIndices, [1, 5], "Selection not shifted on remove at front");
+            objectModel.move(1, 3, 1);
+            compare(listView.ViewItems.selectedIndices, [3, 5], "Selection not moved");
+            objectModel.reset();
+            compare(listView.ViewItems.selectedIndices.length, 0, "Selection not cleared with the rows");
+        }
+
         function test_toggle_selectMode_data() {
             return [
                 {tag: "When not selected", index: 0, selected: false},
@@ -1238,5 +1289,18 @@ Item {
             // restore height
             testItem.height = height;
         }
+
+        function test_released_listitem_resets_swipe() {
+            var item = releasedItemComponent.createObject(testColumn);
+            verify(item);
+            waitForRendering(item);
+            swipe(item, centerOf(item).x, centerOf(item).y, units.gu(10), 0);
+            compare(item.swiped, true, "ListItem not swiped");
+            // release the item from its parent, as views do
+            item.parent = null;
+            compare(item.swiped, false, "Released ListItem still swiped");
+            compare(item.highlighted, false, "Released ListItem still highlighted");
+            item.destroy();
+        }
     }
 }
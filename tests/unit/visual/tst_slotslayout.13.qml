@@ -457,7 +457,8 @@ Item {
                 var slot = slots[i]
 
                 expectedX += slot.SlotsLayout.padding.leading
-                compare(slot.x, expectedX, "Slot's horizontal position")
+                //the layout is updated in the polish phase, so let it catch up with the changes
+                tryCompare(slot, "x", expectedX, 1000, "Slot's horizontal position")
                 expectedX += slot.width
                 expectedX += slot.SlotsLayout.padding.trailing
 
@@ -467,17 +468,13 @@ Item {
                     compare(slot.y, 0, "Override vertical positioning: vertical position")
                 } else {
                     if (mustAlignSlotsToTop(item)) {
-                        compare(slot.anchors.top, item.top,
-                                "Automatic vertical positioning: top anchor, \"aligned to the top\" positioning mode")
-                        compare(slot.anchors.topMargin, item.padding.top + slot.SlotsLayout.padding.top,
-                                "Automatic vertical positioning: topMargin, \"aligned to the top\" positioning mode")
+                        tryCompare(slot, "y", item.padding.top + slot.SlotsLayout.padding.top, 1000,
+                                   "Automatic vertical positioning: \"aligned to the top\" positioning mode")
                     } else {
-                        compare(slot.anchors.verticalCenter, item.verticalCenter,
-                                "Automatic vertical positioning: verticalCenter anchor, \"vertically centered\" positioning mode ")
-                        compare(slot.anchors.verticalCenterOffset,
-                                (item.padding.top - item.padding.bottom
-                                 + slot.SlotsLayout.padding.top - slot.SlotsLayout.padding.bottom) / 2.0,
-                                "Automatic vertical positioning: verticalCenterOffset, \"vertically centered\" positioning mode ")
+                        tryCompare(slot, "y", Math.round((item.height - slot.height) / 2.0)
+                                   + (item.padding.top - item.padding.bottom
+                                      + slot.SlotsLayout.padding.top - slot.SlotsLayout.padding.bottom) / 2.0, 1000,
+                                   "Automatic vertical positioning: \"vertically centered\" positioning mode")
                     }
                 }
             }
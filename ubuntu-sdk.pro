@@ -26,6 +26,19 @@ license.target = license
 license.commands = cd $$PWD; $$PWD/tests/license/checklicense.sh
 QMAKE_EXTRA_TARGETS += license
 
+# compile check of the toolkit components and theme styles of the build tree,
+# reports the compile time of each document and fails on compile errors; not
+# part of the install, nothing is shipped precompiled
+qmlcompilecheck.target = qmlcompilecheck
+qmlcompilecheck.commands = QML2_IMPORT_PATH=$$OUT_PWD/qml \
+                           UBUNTU_UI_TOOLKIT_THEMES_PATH=$$OUT_PWD/qml \
+                           LD_LIBRARY_PATH=$$OUT_PWD/lib \
+                           $$OUT_PWD/ubuntu-ui-toolkit-launcher/ubuntu-ui-toolkit-launcher -precompile \
+                           $$OUT_PWD/qml/Ubuntu/Components/1.3 \
+                           $$OUT_PWD/qml/Ubuntu/Components/Themes/*/1.3/*Style.qml
+qmlcompilecheck.depends = sub-src sub-src_uitk_launcher
+QMAKE_EXTRA_TARGETS += qmlcompilecheck
+
 check.target = check
 check.commands = $$PWD/tests/checkresults.sh $$OUT_PWD/tests/*.xml || exit 1;
 check.commands += pep8 $$PWD || exit 1;
@@ -33,6 +33,8 @@
 #include <QtQuick/private/qsgcontext_p.h>
 #include <QtCore/QCommandLineParser>
 #include <QtCore/QCommandLineOption>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
 #include <UbuntuToolkit/private/mousetouchadaptor_p.h>
 #include <UbuntuMetrics/applicationmonitor.h>
 #include <QtGui/QTouchDevice>
@@ -48,8 +50,54 @@ static QObject *testRootObject(QQmlEngine *engine, QJSEngine *jsEngine)
     return s_testRootObject;
 }
 
+// Compiles the given QML documents (or all QML documents found under the given
+// directories) without instantiating them, reporting the compile time of each
+// one and the documents which fail to compile. Returns the number of failing
+// documents.
+static int precompile(QQmlEngine *engine, const QStringList &paths)
+{
+    QStringList documents;
+    Q_FOREACH(const QString &path, paths) {
+        if (QFileInfo(path).isDir()) {
+            QDirIterator it(path, QStringList() << "*.qml", QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                documents.append(it.next());
+            }
+        } else {
+            documents.append(path);
+        }
+    }
+
+    int failures = 0;
+    qint64 total = 0;
+    QElapsedTimer timer;
+    Q_FOREACH(const QString &document, documents) {
+        timer.start();
+        QQmlComponent component(engine, QUrl::fromLocalFile(QFileInfo(document).absoluteFilePath()),
+                                QQmlComponent::PreferSynchronous);
+        while (component.isLoading())
+            QCoreApplication::processEvents();
+        const qint64 elapsed = timer.nsecsElapsed();
+        total += elapsed;
+        if (component.isError()) {
+            qCritical("%s", qPrintable(component.errorString()));
+            failures++;
+        } else {
+            std::cout << QString::number(elapsed / 1000000.0, 'f', 3).toStdString()
+                      << " ms " << document.toStdString() << std::endl;
+        }
+    }
+    std::cout << "Compiled " << (documents.count() - failures) << "/" << documents.count()
+              << " documents in " << QString::number(total / 1000000.0, 'f', 3).toStdString()
+              << " ms" << std::endl;
+    return failures;
+}
+
 int main(int argc, const char *argv[])
 {
+    // Anchor the metrics time stamps to the start of the process so that the
+    // logged events can be used to measure the startup time.
+    UMEventUtils::timeStamp();
     // QPlatformIntegration::ThreadedOpenGL
     setenv("QML_FORCE_THREADED_RENDERER", "1", 1);
     // QPlatformIntegration::BufferQueueingOpenGL
@@ -80,8 +128,12 @@ int main(int argc, const char *argv[])
         "only), a local or absolute filename", "device");
     QCommandLineOption _metricsLoggingFilter(
         "metrics-logging-filter", "Filter metrics logging, <filter> is a list of events separated "
-        "by a comma ('window', 'process', 'frame' or '*'), events not filtered are discarded",
+        "by a comma ('window', 'process', 'frame', 'generic', 'input', 'jank' or '*'), events not "
+        "filtered are discarded",
         "filter");
+    QCommandLineOption _precompile(
+        "precompile", "Compile the given documents, or the documents found in the given "
+        "directories, without showing them and exit");
 
     args.addOption(_import);
     args.addOption(_enableTouch);
@@ -92,6 +144,7 @@ int main(int argc, const char *argv[])
     args.addOption(_metricsOverlay);
     args.addOption(_metricsLogging);
     args.addOption(_metricsLoggingFilter);
+    args.addOption(_precompile);
     args.addPositionalArgument("filename", "Document to be viewed");
     args.setSingleDashWordOptionMode(QCommandLineParser::ParseAsLongOptions);
     args.addHelpOption();
@@ -109,6 +162,14 @@ int main(int argc, const char *argv[])
         args.showHelp(1);
     }
 
+    if (args.isSet(_precompile)) {
+        QQmlEngine precompileEngine;
+        Q_FOREACH(const QString &path, args.values(_import)) {
+            precompileEngine.addImportPath(path);
+        }
+        return precompile(&precompileEngine, args.positionalArguments()) > 0 ? 1 : 0;
+    }
+
     // Testability is only supported out of the box by QApplication not QGuiApplication
     if (args.isSet(_testability) || getenv("QT_LOAD_TESTABILITY")) {
         QLibrary testLib(QLatin1String("qttestability"));
@@ -230,6 +291,10 @@ int main(int argc, const char *argv[])
                 filter |= UMApplicationMonitor::FrameEvent;
             } else if (filterList[i] == "generic") {
                 filter |= UMApplicationMonitor::GenericEvent;
+            } else if (filterList[i] == "input") {
+                filter |= UMApplicationMonitor::InputEvent;
+            } else if (filterList[i] == "jank") {
+                filter |= UMApplicationMonitor::JankEvent;
             }
         }
         applicationMonitor->setLoggingFilter(filter);
@@ -263,6 +328,8 @@ int main(int argc, const char *argv[])
         window->setFlags(Qt::FramelessWindowHint);
     }
     window->show();
+    // The root object is created and shown, lets startup measurements know.
+    applicationMonitor->logEvent(UMApplicationMonitor::UserInterfaceReady);
 
     if (args.isSet(_enableTouch)) {
         // has no effect if we have touch screen